@@ -1,7 +1,1736 @@
-#include <stdlib.h>
+// a small streaming threshold, a low parallel threshold and a pool of four threads on any machine,
+// so the tests reach the non temporal store and the parallel paths
+#define TINYSTL_STREAMING_THRESHOLD (1 << 20)
+#define TINYSTL_PARALLEL_THRESHOLD (1 << 16)
+#define TINYSTL_POOL_THREADS 4
 
-int main()
-{
-    // run tests
-    system("pause");
+#include "test.h"
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "algobase.h"
+#include "binary_search.h"
+#include "bloom_filter.h"
+#include "construct.h"
+#include "cuckoo_filter.h"
+#include "eytzinger_index.h"
+#include "execution.h"
+#include "heap_algo.h"
+#include "lru_cache.h"
+#include "memory.h"
+#include "merge.h"
+#include "mmap_array.h"
+#include "numeric.h"
+#include "parallel_set_algo.h"
+#include "radix_sort.h"
+#include "set_algo.h"
+#include "soa.h"
+#include "sort.h"
+#include "sort_network.h"
+#include "thread_pool.h"
+#include "top_k.h"
+#include "uninitialized.h"
+#include "views.h"
+
+// random inputs shared by the sections below
+
+namespace {
+
+    uint32_t test_rand(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // the inputs pattern defeating sorts special case: random, sorted, reversed, organ pipe, few distinct keys
+    std::vector<int> sort_pattern(int kind, size_t n, uint32_t seed) {
+        std::vector<int> v(n);
+        for (size_t i = 0; i < n; ++i) {
+            const int x = static_cast<int>(test_rand(seed));
+            const int k = static_cast<int>(i);
+            v[i] = kind == 0 ? x : kind == 1 ? k : kind == 2 ? -k : kind == 3 ? (i < n / 2 ? k : static_cast<int>(n) - k) : x % 4;
+        }
+        return v;
+    }
+
+}
+
+// soa.h
+
+TEST(soa_vector, fields_are_contiguous_arrays) {
+    tinystl::soa_vector<int, double> v;
+    for (int i = 0; i < 100; ++i) v.emplace_back(i, i * 0.5);
+    EXPECT_EQ(v.size(), 100u);
+    EXPECT_TRUE(v.capacity() >= 100u);
+    const int* keys = v.data<0>();
+    const double* halves = v.data<1>();
+    bool ok = true;
+    for (int i = 0; i < 100; ++i) ok = ok && keys[i] == i && halves[i] == i * 0.5;
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(v[42].get<1>(), 21.0);
+}
+
+TEST(soa_vector, copy_and_move_keep_records) {
+    tinystl::soa_vector<int, long> v(3, tinystl::soa_value<int, long>(7, 8L));
+    v.push_back(tinystl::soa_value<int, long>(1, 2L));
+    tinystl::soa_vector<int, long> c(v);
+    tinystl::soa_vector<int, long> m(tinystl::move(v));
+    EXPECT_EQ(c.size(), 4u);
+    EXPECT_EQ(m.size(), 4u);
+    EXPECT_TRUE(v.empty());
+    EXPECT_TRUE(c[3] == (tinystl::soa_value<int, long>(1, 2L)));
+    EXPECT_TRUE(m[0] == c[0]);
+    c.resize(2);
+    EXPECT_EQ(c.size(), 2u);
+    c.pop_back();
+    EXPECT_EQ(c.back().get<0>(), 7);
+}
+
+TEST(soa_vector, proxy_swap_moves_every_field) {
+    tinystl::soa_vector<int, char> v;
+    v.emplace_back(1, 'a');
+    v.emplace_back(2, 'b');
+    tinystl::swap(v[0], v[1]);
+    EXPECT_TRUE(v[0].get<0>() == 2 && v[0].get<1>() == 'b');
+    tinystl::iter_swap(v.begin(), v.begin() + 1);
+    EXPECT_TRUE(v[0].get<0>() == 1 && v[0].get<1>() == 'a');
+    tinystl::iter_swap(v.begin(), v.end() - 1);
+    EXPECT_TRUE(v[1].get<0>() == 1 && v[1].get<1>() == 'a');
+}
+
+TEST(soa_vector, const_and_mutable_iterators_compare) {
+    tinystl::soa_vector<int> v(5);
+    const tinystl::soa_vector<int>& cv = v;
+    tinystl::soa_vector<int>::iterator it = v.begin();
+    tinystl::soa_vector<int>::const_iterator cit = cv.begin();
+    EXPECT_TRUE(it == cit);
+    EXPECT_TRUE(cit == it);
+    EXPECT_TRUE(it != cv.end());
+    EXPECT_TRUE(it < cv.end());
+    EXPECT_EQ(cv.end() - it, 5);
+    EXPECT_EQ(v.end() - cit, 5);
+}
+
+TEST(soa_vector, heap_sort_orders_records) {
+    tinystl::soa_vector<int, int> v;
+    uint32_t x = 12345;
+    for (int i = 0; i < 500; ++i) {
+        x = x * 1103515245u + 12345u;
+        const int key = static_cast<int>(x >> 20);
+        v.emplace_back(key, -key);
+    }
+    tinystl::make_heap(v.begin(), v.end());
+    tinystl::sort_heap(v.begin(), v.end());
+    bool sorted = true, paired = true;
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (i > 0 && v[i].get<0>() < v[i - 1].get<0>()) sorted = false;
+        if (v[i].get<1>() != -v[i].get<0>()) paired = false;
+    }
+    EXPECT_TRUE(sorted);
+    EXPECT_TRUE(paired);
+}
+
+// mmap_array.h
+
+TEST(mmap_array, persists_across_reopen) {
+    const char* path = "stltest_mmap_array.bin";
+    std::remove(path);
+    {
+        tinystl::mmap_array<uint64_t> a(path, tinystl::mmap_array<uint64_t>::read_write);
+        for (uint64_t i = 0; i < 1000; ++i) a.push_back(i * i);
+        a.flush();
+    }
+    tinystl::mmap_array<uint64_t> r(path);
+    EXPECT_FALSE(r.is_writable());
+    EXPECT_EQ(r.size(), 1000u);
+    bool ok = true;
+    for (uint64_t i = 0; i < 1000; ++i) ok = ok && r[i] == i * i;
+    EXPECT_TRUE(ok);
+    EXPECT_THROW(r.push_back(1), std::runtime_error);
+    EXPECT_THROW(r.at(1000), std::out_of_range);
+    r.close();
+    std::remove(path);
+}
+
+TEST(mmap_array, resize_zero_fills_new_records) {
+    const char* path = "stltest_mmap_array.bin";
+    std::remove(path);
+    tinystl::mmap_array<int> a(path, tinystl::mmap_array<int>::read_write);
+    for (int i = 1; i <= 40; ++i) a.push_back(i);
+    a.resize(10);
+    a.resize(100);
+    bool ok = a.size() == 100;
+    for (int i = 0; i < 10; ++i) ok = ok && a[i] == i + 1;
+    for (int i = 10; i < 100; ++i) ok = ok && a[i] == 0;
+    EXPECT_TRUE(ok);
+    a.close();
+    std::remove(path);
+}
+
+TEST(mmap_array, rejects_corrupt_capacity) {
+    const char* path = "stltest_mmap_array.bin";
+    std::remove(path);
+    {
+        tinystl::mmap_array<uint64_t> a(path, tinystl::mmap_array<uint64_t>::read_write);
+        a.push_back(1);
+    }
+    // a capacity whose file length wraps around to a small number
+    const uint64_t capacity = (UINT64_C(1) << 61) + 1;
+    std::FILE* f = std::fopen(path, "r+b");
+    std::fseek(f, static_cast<long>(offsetof(tinystl::mmap_array_header, capacity)), SEEK_SET);
+    std::fwrite(&capacity, sizeof(capacity), 1, f);
+    std::fclose(f);
+    tinystl::mmap_array<uint64_t> r;
+    EXPECT_THROW(r.open(path), std::runtime_error);
+    EXPECT_FALSE(r.is_open());
+    std::remove(path);
+}
+
+// bloom_filter.h, cuckoo_filter.h
+
+TEST(bloom_filter, no_false_negatives_and_bounded_false_positives) {
+    tinystl::bloom_filter<uint64_t> f(10000, 0.01);
+    for (uint64_t i = 0; i < 10000; ++i) f.insert(i * 7919);
+    bool all = true;
+    for (uint64_t i = 0; i < 10000; ++i) all = all && f.contains(i * 7919);
+    EXPECT_TRUE(all);
+    EXPECT_EQ(f.size(), 10000u);
+    int positives = 0;
+    for (uint64_t i = 0; i < 100000; ++i) positives += f.contains(i * 7919 + 1);
+    EXPECT_TRUE(positives < 3000);
+    f.clear();
+    EXPECT_FALSE(f.contains(0));
+}
+
+TEST(cuckoo_filter, insert_contains_erase) {
+    tinystl::cuckoo_filter<int> f(5000, 0.001);
+    bool inserted = true;
+    for (int i = 0; i < 5000; ++i) inserted = inserted && f.insert(i);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(f.size(), 5000u);
+    bool all = true;
+    for (int i = 0; i < 5000; ++i) all = all && f.contains(i);
+    EXPECT_TRUE(all);
+    for (int i = 0; i < 5000; i += 2) f.erase(i);
+    EXPECT_EQ(f.size(), 2500u);
+    bool odd = true;
+    for (int i = 1; i < 5000; i += 2) odd = odd && f.contains(i);
+    EXPECT_TRUE(odd);
+    int positives = 0;
+    for (int i = 0; i < 5000; i += 2) positives += f.contains(i);
+    EXPECT_TRUE(positives < 100);
+}
+
+TEST(cuckoo_filter, reports_full) {
+    tinystl::cuckoo_filter<int> f(64, 0.01);
+    int stored = 0;
+    for (int i = 0; i < 100000 && f.insert(i); ++i) ++stored;
+    EXPECT_TRUE(stored >= 64);
+    EXPECT_TRUE(static_cast<size_t>(stored) <= f.capacity() + 1);
+}
+
+// lru_cache.h
+
+TEST(lru_cache, evicts_least_recently_used) {
+    tinystl::lru_cache<int, int> c(3);
+    c.put(1, 10);
+    c.put(2, 20);
+    c.put(3, 30);
+    EXPECT_TRUE(c.get(1) != nullptr);
+    c.put(4, 40);
+    EXPECT_FALSE(c.contains(2));
+    EXPECT_TRUE(c.contains(1) && c.contains(3) && c.contains(4));
+    EXPECT_EQ(c.evictions(), 1u);
+    c.put(3, 33);
+    EXPECT_EQ(*c.peek(3), 33);
+    EXPECT_EQ(c.size(), 3u);
+}
+
+TEST(lru_cache, counts_hits_and_misses) {
+    tinystl::lru_cache<int, int> c(100);
+    for (int i = 0; i < 100; ++i) c.put(i, i);
+    for (int i = 0; i < 200; ++i) c.get(i);
+    EXPECT_EQ(c.hits(), 100u);
+    EXPECT_EQ(c.misses(), 100u);
+    // erasing shifts probe runs back, every survivor stays reachable
+    for (int i = 0; i < 100; i += 3) EXPECT_TRUE(c.erase(i));
+    bool ok = true;
+    for (int i = 0; i < 100; ++i) ok = ok && c.contains(i) == (i % 3 != 0);
+    EXPECT_TRUE(ok);
+    c.reset_stats();
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.hits() + c.misses(), 0u);
+}
+
+// memory.h
+
+namespace {
+
+    struct counted_delete {
+        int* calls;
+        void operator()(int* p) const { ++*calls; delete p; }
+    };
+
+    struct final_delete final {
+        void operator()(int* p) const { delete p; }
+    };
+
+    struct alignas(64) cache_line {
+        int value;
+        explicit cache_line(int v) : value(v) {}
+    };
+
+    struct ref_counted : tinystl::intrusive_ref_counter<ref_counted> {
+        int* alive;
+        explicit ref_counted(int* a) : alive(a) { ++*alive; }
+        ~ref_counted() { --*alive; }
+    };
+
+}
+
+TEST(unique_ptr, empty_deleters_take_no_space) {
+    EXPECT_EQ(sizeof(tinystl::unique_ptr<int>), sizeof(int*));
+    tinystl::unique_ptr<int, final_delete> f(new int(3));
+    EXPECT_EQ(*f, 3);
+    int calls = 0;
+    {
+        tinystl::unique_ptr<int, counted_delete> p(new int(1), counted_delete{ &calls });
+        tinystl::unique_ptr<int, counted_delete> q(tinystl::move(p));
+        EXPECT_TRUE(p.get() == nullptr);
+        q.reset(new int(2));
+        EXPECT_EQ(calls, 1);
+    }
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(shared_ptr, counts_and_weak_lock) {
+    tinystl::shared_ptr<int> a = tinystl::make_shared<int>(5);
+    tinystl::weak_ptr<int> w(a);
+    {
+        tinystl::shared_ptr<int> b(a);
+        EXPECT_EQ(a.use_count(), 2);
+        EXPECT_EQ(*w.lock(), 5);
+    }
+    EXPECT_EQ(a.use_count(), 1);
+    a.reset();
+    EXPECT_TRUE(w.expired());
+    EXPECT_TRUE(w.lock().get() == nullptr);
+    EXPECT_THROW(tinystl::shared_ptr<int> c(w), tinystl::bad_weak_ptr);
+}
+
+TEST(shared_ptr, make_shared_honours_over_alignment) {
+    bool aligned = true;
+    for (int i = 0; i < 16; ++i) {
+        tinystl::shared_ptr<cache_line> p = tinystl::make_shared<cache_line>(i);
+        aligned = aligned && reinterpret_cast<uintptr_t>(p.get()) % 64 == 0 && p->value == i;
+    }
+    EXPECT_TRUE(aligned);
+}
+
+TEST(intrusive_ptr, releases_with_last_owner) {
+    int alive = 0;
+    {
+        tinystl::intrusive_ptr<ref_counted> a(new ref_counted(&alive));
+        tinystl::intrusive_ptr<ref_counted> b(a);
+        EXPECT_EQ(a->use_count(), 2);
+        a.reset();
+        EXPECT_EQ(alive, 1);
+    }
+    EXPECT_EQ(alive, 0);
+}
+
+// algobase.h
+
+TEST(algobase, equal_and_mismatch_find_every_position) {
+    for (size_t n = 0; n < 200; n += (n < 40 ? 1 : 37)) {
+        std::vector<int> a(n), b;
+        for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(i * 31);
+        b = a;
+        bool ok = tinystl::equal(a.data(), a.data() + n, b.data()) && tinystl::mismatch(a.data(), a.data() + n, b.data()).first == a.data() + n;
+        for (size_t k = 0; k < n; ++k) {
+            b[k] ^= 0x100;
+            ok = ok && !tinystl::equal(a.data(), a.data() + n, b.data());
+            ok = ok && tinystl::mismatch(a.data(), a.data() + n, b.data()).second == b.data() + k;
+            b[k] ^= 0x100;
+        }
+        EXPECT_TRUE(ok);
+    }
+}
+
+TEST(algobase, lexicographical_compare_matches_std) {
+    std::vector<short> a, b;
+    uint32_t x = 7;
+    bool ok = true;
+    for (int round = 0; round < 500; ++round) {
+        a.resize(round % 70);
+        b.resize((round * 7) % 70);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<short>(i < 20 ? i : (x = x * 1664525u + 1013904223u) >> 31);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<short>(i < 20 ? i : (x = x * 1664525u + 1013904223u) >> 31);
+        const short* pa = a.data();
+        const short* pb = b.data();
+        ok = ok && tinystl::lexicographical_compare(pa, pa + a.size(), pb, pb + b.size()) ==
+            std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    }
+    EXPECT_TRUE(ok);
+    const unsigned char u[] = { 1, 2, 200 }, v[] = { 1, 2, 3, 4 };
+    EXPECT_FALSE(tinystl::lexicographical_compare(u, u + 3, v, v + 4));
+    EXPECT_TRUE(tinystl::lexicographical_compare(v, v + 2, u, u + 3));
+}
+
+namespace {
+
+    struct rgb {
+        unsigned char r, g, b;
+        bool operator==(const rgb& o) const { return r == o.r && g == o.g && b == o.b; }
+    };
+
+    // fills [off, off + n) of a guarded buffer and checks the pattern and both guards
+    template <class T>
+    bool fill_n_checked(size_t off, size_t n, const T& value, const T& guard) {
+        std::vector<T> buf(off + n + 8, guard);
+        tinystl::fill_n(buf.data() + off, n, value);
+        for (size_t i = 0; i < buf.size(); ++i)
+            if (!(buf[i] == (i >= off && i < off + n ? value : guard))) return false;
+        return true;
+    }
+
+}
+
+TEST(algobase, fill_n_writes_exactly_the_range) {
+    bool ok = true;
+    const rgb red = { 255, 0, 0 }, zero = { 0, 0, 0 };
+    for (size_t off = 0; off < 5; ++off) {
+        for (size_t n = 0; n < 300; n += (n < 70 ? 1 : 29)) {
+            ok = ok && fill_n_checked<char>(off, n, 'x', 0);
+            ok = ok && fill_n_checked<short>(off, n, 0x1234, 0);
+            ok = ok && fill_n_checked<rgb>(off, n, red, zero);
+            ok = ok && fill_n_checked<double>(off, n, 2.5, 0.0);
+        }
+    }
+    EXPECT_TRUE(ok);
+    std::vector<long long> v(1000, 1);
+    tinystl::fill(v.data() + 3, v.data() + 997, -7LL);
+    EXPECT_TRUE(v[2] == 1 && v[3] == -7 && v[996] == -7 && v[997] == 1);
+}
+
+TEST(algobase, fill_n_streams_large_ranges) {
+    const size_t bytes = tinystl::simd_streaming_threshold() + 4096;
+    EXPECT_TRUE(fill_n_checked<int>(3, bytes / sizeof(int), 0x5a5a0101, -1));
+    const rgb blue = { 0, 0, 255 }, zero = { 0, 0, 0 };
+    EXPECT_TRUE(fill_n_checked<rgb>(1, bytes / sizeof(rgb), blue, zero));
+}
+
+TEST(algobase, copy_and_move_any_size) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1, 7, 31, 64, 255, 256, 1000, 4097, (1 << 20) / 4 + 13 };
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        const size_t n = sizes[k];
+        std::vector<int> src(n + 1), dst(n + 3, -1);
+        for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<int>(i * 2654435761u);
+        int* end = tinystl::copy(src.data() + 1, src.data() + 1 + n, dst.data() + 1);
+        ok = ok && end == dst.data() + 1 + n && dst[0] == -1 && dst[n + 1] == -1;
+        ok = ok && std::equal(src.begin() + 1, src.end(), dst.begin() + 1);
+        std::fill(dst.begin(), dst.end(), -1);
+        int* first = tinystl::move_backward(src.data(), src.data() + n, dst.data() + 2 + n);
+        ok = ok && first == dst.data() + 2 && dst[1] == -1 && dst[n + 2] == -1;
+        ok = ok && std::equal(src.begin(), src.begin() + n, dst.begin() + 2);
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(algobase, copy_handles_overlap) {
+    std::vector<int> v(5000), w;
+    for (int i = 0; i < 5000; ++i) v[i] = i;
+    w = v;
+    tinystl::copy(v.data() + 100, v.data() + 5000, v.data());
+    std::copy(w.begin() + 100, w.end(), w.begin());
+    EXPECT_TRUE(v == w);
+    tinystl::copy_backward(v.data(), v.data() + 4000, v.data() + 4900);
+    std::copy_backward(w.begin(), w.begin() + 4000, w.begin() + 4900);
+    EXPECT_TRUE(v == w);
+}
+
+namespace {
+
+    // the compaction kernels against std for one element type, over sizes around the chunk length
+    template <class T>
+    bool compaction_matches_std() {
+        bool ok = true;
+        const size_t sizes[] = { 0, 1, 5, 63, 64, 65, 127, 128, 129, 1000, 4099 };
+        for (size_t k = 0; k < 11; ++k) {
+            const size_t n = sizes[k];
+            std::vector<T> v(n);
+            uint32_t seed = 13 + static_cast<uint32_t>(k);
+            for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(test_rand(seed) % 5);
+            auto odd = [](T x) { return static_cast<int>(x) % 2 == 1; };
+
+            std::vector<T> a(n + 1, T(9)), b(n + 1, T(9));
+            T* end = tinystl::copy_if(v.data(), v.data() + n, a.data(), odd);
+            const size_t kept = static_cast<size_t>(std::copy_if(v.begin(), v.end(), b.begin(), odd) - b.begin());
+            ok = ok && end == a.data() + kept && a == b;
+
+            a = v; b = v;
+            end = tinystl::remove_if(a.data(), a.data() + n, odd);
+            ok = ok && end - a.data() == std::remove_if(b.begin(), b.end(), odd) - b.begin() && std::equal(a.data(), end, b.begin());
+
+            a = v; b = v;
+            end = tinystl::unique(a.data(), a.data() + n);
+            ok = ok && end - a.data() == std::unique(b.begin(), b.end()) - b.begin() && std::equal(a.data(), end, b.begin());
+
+            // partition order is unspecified: the same elements, split at the same point
+            a = v;
+            end = tinystl::partition(a.data(), a.data() + n, odd);
+            ok = ok && static_cast<size_t>(end - a.data()) == kept;
+            ok = ok && std::all_of(a.data(), end, odd) && std::none_of(end, a.data() + n, odd);
+            std::vector<T> sa(a.begin(), a.begin() + n), sv = v;
+            std::sort(sa.begin(), sa.end());
+            std::sort(sv.begin(), sv.end());
+            ok = ok && sa == sv;
+        }
+        return ok;
+    }
+
+}
+
+TEST(algobase, compaction_matches_std) {
+    EXPECT_TRUE(compaction_matches_std<int>());
+    EXPECT_TRUE(compaction_matches_std<int64_t>());
+    EXPECT_TRUE(compaction_matches_std<unsigned char>());
+    EXPECT_TRUE(compaction_matches_std<short>());
+    EXPECT_TRUE(compaction_matches_std<double>());
+}
+
+TEST(algobase, compaction_generic_iterators) {
+    // a non arithmetic element takes the generic algorithms
+    std::vector<tinystl::pair<int, int>> v;
+    for (int i = 0; i < 300; ++i) v.push_back(tinystl::pair<int, int>(i / 3, i % 3));
+    auto first_odd = [](const tinystl::pair<int, int>& p) { return p.first % 2 == 1; };
+    tinystl::pair<int, int>* end = tinystl::remove_if(v.data(), v.data() + v.size(), first_odd);
+    bool ok = end - v.data() == 150;
+    for (tinystl::pair<int, int>* p = v.data(); p != end; ++p) ok = ok && p->first % 2 == 0;
+    end = tinystl::partition(v.data(), end, [](const tinystl::pair<int, int>& p) { return p.second == 0; });
+    ok = ok && end - v.data() == 50 && std::all_of(v.data(), end, [](const tinystl::pair<int, int>& p) { return p.second == 0; });
+    EXPECT_TRUE(ok);
+}
+
+// iterator.h
+
+namespace {
+
+    // a wrapped pointer: a contiguous iterator that is not a pointer
+    template <class T>
+    struct wrapped_ptr : public tinystl::iterator<tinystl::contiguous_iterator_tag, T> {
+        T* p;
+        explicit wrapped_ptr(T* ptr = nullptr) : p(ptr) {}
+        T& operator*() const { return *p; }
+        T* operator->() const { return p; }
+        T& operator[](ptrdiff_t n) const { return p[n]; }
+        wrapped_ptr& operator++() { ++p; return *this; }
+        wrapped_ptr& operator--() { --p; return *this; }
+        wrapped_ptr operator++(int) { return wrapped_ptr(p++); }
+        wrapped_ptr operator--(int) { return wrapped_ptr(p--); }
+        wrapped_ptr& operator+=(ptrdiff_t n) { p += n; return *this; }
+        wrapped_ptr& operator-=(ptrdiff_t n) { p -= n; return *this; }
+        wrapped_ptr operator+(ptrdiff_t n) const { return wrapped_ptr(p + n); }
+        wrapped_ptr operator-(ptrdiff_t n) const { return wrapped_ptr(p - n); }
+        ptrdiff_t operator-(const wrapped_ptr& rhs) const { return p - rhs.p; }
+        bool operator==(const wrapped_ptr& rhs) const { return p == rhs.p; }
+        bool operator!=(const wrapped_ptr& rhs) const { return p != rhs.p; }
+        bool operator<(const wrapped_ptr& rhs) const { return p < rhs.p; }
+    };
+
+    // an index into a fixed array, without an operator->
+    struct slot_iter : public tinystl::iterator<tinystl::contiguous_iterator_tag, int> {
+        static int slots[8];
+        ptrdiff_t i;
+        explicit slot_iter(ptrdiff_t k) : i(k) {}
+    };
+    int slot_iter::slots[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+}
+
+namespace tinystl {
+    template <>
+    struct iterator_address<slot_iter> {
+        static int* get(const slot_iter& it) noexcept { return slot_iter::slots + it.i; }
+    };
+}
+
+TEST(iterator, contiguous_tag_and_to_address) {
+    EXPECT_TRUE(tinystl::is_contiguous_iterator<int*>::value);
+    EXPECT_TRUE(tinystl::is_contiguous_iterator<const double*>::value);
+    EXPECT_TRUE(tinystl::is_random_access_iterator<int*>::value);
+    EXPECT_TRUE(tinystl::is_contiguous_iterator<wrapped_ptr<int>>::value);
+    EXPECT_FALSE((tinystl::is_contiguous_iterator<tinystl::soa_iterator<false, int, double>>::value));
+    int a[4] = { 1, 2, 3, 4 };
+    int* p = a + 2;
+    int* const& ref = p;
+    EXPECT_TRUE(tinystl::to_address(ref) == a + 2);
+    EXPECT_TRUE(tinystl::to_address(wrapped_ptr<int>(a + 3)) == a + 3);
+    EXPECT_TRUE(tinystl::to_address(slot_iter(5)) == slot_iter::slots + 5);
+}
+
+TEST(iterator, wrapped_pointers_reach_the_pointer_paths) {
+    // the results are mapped back onto the wrapped iterators
+    std::vector<int> src(1000), dst(1001, -1);
+    for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<int>(i);
+    wrapped_ptr<int> f(src.data()), l(src.data() + src.size()), d(dst.data());
+    EXPECT_TRUE(tinystl::copy(f, l, d) == d + 1000);
+    EXPECT_TRUE(std::equal(src.begin(), src.end(), dst.begin()) && dst[1000] == -1);
+    EXPECT_TRUE(tinystl::equal(f, l, d));
+    EXPECT_TRUE(tinystl::copy_backward(f, f + 500, d + 800) == d + 300);
+    EXPECT_EQ(dst[300], 0);
+    EXPECT_EQ(dst[799], 499);
+    EXPECT_TRUE(tinystl::move(f, l, d) == d + 1000);
+    EXPECT_TRUE(tinystl::move_backward(f, l, d + 1000) == d);
+    EXPECT_TRUE(tinystl::fill_n(d, 1000, 7) == d + 1000);
+    EXPECT_EQ(std::count(dst.begin(), dst.end(), 7), 1000);
+    tinystl::fill(d + 10, d + 20, 3);
+    EXPECT_EQ(std::count(dst.begin(), dst.end(), 3), 10);
+    EXPECT_FALSE(tinystl::equal(f, l, d));
+}
+
+namespace {
+
+    // reversed pointer ranges against std for one element type, around the vector widths
+    template <class T>
+    bool reverse_copies_match_std() {
+        typedef tinystl::reverse_iterator<T*> rev;
+        typedef tinystl::reverse_iterator<const T*> crev;
+        bool ok = true;
+        const size_t sizes[] = { 0, 1, 3, 15, 16, 17, 31, 32, 33, 100, 1000 };
+        for (size_t k = 0; k < 11; ++k) {
+            const size_t n = sizes[k];
+            std::vector<T> src(n), a(n + 2, T(1)), b(n + 2, T(1));
+            for (size_t i = 0; i < n; ++i) src[i] = static_cast<T>(i * 3 + 5);
+            const T* f = src.data();
+            const T* l = src.data() + n;
+            std::reverse_copy(src.begin(), src.end(), b.begin() + 1);
+            // reversed source into a forward destination, and forward source into a reversed destination
+            ok = ok && tinystl::copy(crev(l), crev(f), a.data() + 1) == a.data() + 1 + n && a == b;
+            std::fill(a.begin(), a.end(), T(1));
+            ok = ok && tinystl::move(f, l, rev(a.data() + 1 + n)) == rev(a.data() + 1) && a == b;
+            std::fill(a.begin(), a.end(), T(1));
+            ok = ok && tinystl::copy_backward(crev(l), crev(f), a.data() + 1 + n) == a.data() + 1 && a == b;
+            std::fill(a.begin(), a.end(), T(1));
+            ok = ok && tinystl::move_backward(f, l, rev(a.data() + 1)) == rev(a.data() + 1 + n) && a == b;
+            // reversed into reversed is a plain copy of the bases
+            std::fill(a.begin(), a.end(), T(1));
+            tinystl::copy(crev(l), crev(f), rev(a.data() + 1 + n));
+            ok = ok && std::equal(src.begin(), src.end(), a.begin() + 1) && a[0] == T(1) && a[n + 1] == T(1);
+        }
+        return ok;
+    }
+
+}
+
+TEST(iterator, reversed_pointer_copies_match_std) {
+    EXPECT_TRUE(reverse_copies_match_std<unsigned char>());
+    EXPECT_TRUE(reverse_copies_match_std<short>());
+    EXPECT_TRUE(reverse_copies_match_std<int>());
+    EXPECT_TRUE(reverse_copies_match_std<float>());
+    EXPECT_TRUE(reverse_copies_match_std<int64_t>());
+    EXPECT_TRUE(reverse_copies_match_std<double>());
+}
+
+TEST(iterator, reversed_overlap_and_wrapped) {
+    typedef tinystl::reverse_iterator<int*> rev;
+    // overlapping ranges keep the order the element loop defines
+    std::vector<int> v(100), w(100);
+    for (int i = 0; i < 100; ++i) v[i] = w[i] = i;
+    tinystl::copy(rev(v.data() + 60), rev(v.data()), v.data() + 20);
+    std::copy(std::vector<int>::reverse_iterator(w.begin() + 60), w.rend(), w.begin() + 20);
+    EXPECT_TRUE(v == w);
+    // reversed wrapped pointers unwrap to reversed pointers
+    std::vector<int> src(500), dst(500);
+    for (int i = 0; i < 500; ++i) src[i] = i;
+    typedef tinystl::reverse_iterator<wrapped_ptr<int>> wrev;
+    EXPECT_TRUE(tinystl::copy(wrev(wrapped_ptr<int>(src.data() + 500)), wrev(wrapped_ptr<int>(src.data())), dst.data()) == dst.data() + 500);
+    EXPECT_TRUE(dst[0] == 499 && dst[499] == 0);
+}
+
+TEST(iterator, reverse_iterator_operators) {
+    int a[5] = { 0, 1, 2, 3, 4 };
+    typedef tinystl::reverse_iterator<int*> rev;
+    EXPECT_TRUE((std::is_same<rev::iterator_category, tinystl::random_access_iterator_tag>::value));
+    rev r(a + 5);
+    EXPECT_EQ(r[1], 3);
+    rev old = r++;
+    EXPECT_EQ(*old, 4);
+    EXPECT_EQ(*r, 3);
+    old = r--;
+    EXPECT_EQ(*old, 3);
+    EXPECT_EQ(*(2 + r), 2);
+    EXPECT_EQ(*(r + 4), 0);
+    EXPECT_EQ(*((r + 4) - 1), 1);
+    tinystl::reverse_iterator<const int*> c(r);
+    EXPECT_EQ(*c, 4);
+}
+
+// sort.h
+
+TEST(sort, matches_std_on_patterns) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1, 2, 5, 16, 17, 31, 100, 1000, 30000 };
+    for (int kind = 0; kind < 5; ++kind) {
+        for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+            std::vector<int> v = sort_pattern(kind, sizes[k], 42 + kind), w = v;
+            tinystl::sort(v.data(), v.data() + v.size());
+            std::sort(w.begin(), w.end());
+            ok = ok && v == w;
+            std::vector<double> d(v.begin(), v.end()), e = d;
+            tinystl::sort(d.data(), d.data() + d.size(), tinystl::greater<double>());
+            std::sort(e.begin(), e.end(), std::greater<double>());
+            ok = ok && d == e;
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(sort, partial_sort_and_nth_element) {
+    bool ok = true;
+    for (int kind = 0; kind < 5; ++kind) {
+        std::vector<int> v = sort_pattern(kind, 5000, 7 + kind), sorted = v;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t cuts[] = { 0, 1, 100, 2500, 4999 };
+        for (size_t c = 0; c < 5; ++c) {
+            std::vector<int> p = v;
+            tinystl::partial_sort(p.data(), p.data() + cuts[c], p.data() + p.size());
+            ok = ok && std::equal(p.begin(), p.begin() + cuts[c], sorted.begin());
+            std::vector<int> q = v;
+            const size_t nth = cuts[c];
+            tinystl::nth_element(q.data(), q.data() + nth, q.data() + q.size());
+            ok = ok && q[nth] == sorted[nth];
+            for (size_t i = 0; i < q.size(); ++i) ok = ok && (i < nth ? q[i] <= q[nth] : q[i] >= q[nth]);
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(sort, partial_sort_copy_matches_std) {
+    bool ok = true;
+    const size_t outs[] = { 0, 1, 10, 999, 1000, 1500 };
+    for (int kind = 0; kind < 5; ++kind) {
+        const std::vector<int> v = sort_pattern(kind, 1000, 19 + kind);
+        for (size_t k = 0; k < 6; ++k) {
+            std::vector<int> a(outs[k], -1), b(outs[k], -1);
+            int* end = tinystl::partial_sort_copy(v.data(), v.data() + v.size(), a.data(), a.data() + a.size());
+            std::vector<int>::iterator std_end = std::partial_sort_copy(v.begin(), v.end(), b.begin(), b.end());
+            ok = ok && end - a.data() == std_end - b.begin() && a == b;
+            tinystl::partial_sort_copy(v.data(), v.data() + v.size(), a.data(), a.data() + a.size(), tinystl::greater<int>());
+            std::partial_sort_copy(v.begin(), v.end(), b.begin(), b.end(), std::greater<int>());
+            ok = ok && a == b;
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(sort, sorts_soa_vector_records) {
+    tinystl::soa_vector<int, int> v;
+    std::vector<int> keys = sort_pattern(0, 3000, 99);
+    for (size_t i = 0; i < keys.size(); ++i) v.emplace_back(keys[i] % 1000, static_cast<int>(i));
+    tinystl::sort(v.begin(), v.end());
+    bool ok = true;
+    for (size_t i = 0; i < v.size(); ++i) {
+        ok = ok && keys[v[i].get<1>()] % 1000 == v[i].get<0>();
+        if (i > 0) ok = ok && tinystl::soa_value<int, int>(v[i - 1]) < tinystl::soa_value<int, int>(v[i]);
+    }
+    EXPECT_TRUE(ok);
+}
+
+// sort_network.h
+
+namespace {
+
+    template <size_t N, class T, class Compared>
+    bool static_sort_matches(const T* src, Compared comp) {
+        T a[N], b[N];
+        std::copy(src, src + N, a);
+        std::copy(src, src + N, b);
+        tinystl::static_sort<N>(a, comp);
+        std::sort(b, b + N, comp);
+        return std::equal(a, a + N, b);
+    }
+
+    template <size_t N>
+    bool static_sort_sizes(const int* src) {
+        return static_sort_matches<N>(src, tinystl::less<int>()) && static_sort_matches<N>(src, tinystl::greater<int>()) &&
+            static_sort_sizes<N - 1>(src);
+    }
+    template <>
+    bool static_sort_sizes<0>(const int*) { return true; }
+
+    // a key with a tag, the comparison looks at the key only
+    struct tagged {
+        int key, tag;
+    };
+    struct tagged_less {
+        bool operator()(const tagged& x, const tagged& y) const { return x.key < y.key; }
+    };
+
+}
+
+TEST(sort_network, static_sort_every_size) {
+    uint32_t seed = 50;
+    int src[33];
+    bool ok = true;
+    for (int round = 0; round < 200 && ok; ++round) {
+        for (int i = 0; i < 33; ++i) src[i] = static_cast<int>(test_rand(seed) % (round % 2 ? 5 : 1000)) - 2;
+        ok = static_sort_sizes<33>(src);
+    }
+    EXPECT_TRUE(ok);
+
+    // the branching exchange for a key that is not arithmetic
+    tagged t[11];
+    for (int i = 0; i < 11; ++i) t[i] = tagged{ static_cast<int>(test_rand(seed) % 100), i };
+    tinystl::static_sort<11>(t, tagged_less());
+    ok = true;
+    for (int i = 1; i < 11; ++i) ok = ok && t[i - 1].key <= t[i].key;
+    EXPECT_TRUE(ok);
+
+    const double d[] = { 3.5, -0.0, 1e300, -1e-300, 2.0, 0.0, -7.25 };
+    EXPECT_TRUE((static_sort_matches<7>(d, tinystl::less<double>())));
+}
+
+TEST(sort_network, small_sorts_through_the_vector_network) {
+    // sizes 8 to 16 of 4 byte keys go through the vector network inside sort
+    uint32_t seed = 50;
+    bool ok = true;
+    for (size_t n = 1; n <= 16 && ok; ++n) {
+        for (int round = 0; round < 50 && ok; ++round) {
+            std::vector<int> a(n);
+            std::vector<unsigned> u(n);
+            std::vector<float> f(n);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = static_cast<int>(test_rand(seed));
+                u[i] = test_rand(seed);
+                f[i] = static_cast<float>(static_cast<int>(test_rand(seed) % 2001) - 1000) / 8.0f;
+            }
+            std::vector<int> ea(a);
+            std::vector<unsigned> eu(u);
+            std::vector<float> ef(f);
+            std::sort(ea.begin(), ea.end());
+            std::sort(eu.begin(), eu.end());
+            std::sort(ef.begin(), ef.end());
+            tinystl::sort(a.data(), a.data() + n);
+            tinystl::sort(u.data(), u.data() + n);
+            tinystl::sort(f.data(), f.data() + n);
+            ok = a == ea && u == eu && f == ef;
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(sort_network, static_min_max_element) {
+    uint32_t seed = 50;
+    int a[13];
+    bool ok = true;
+    for (int round = 0; round < 500 && ok; ++round) {
+        for (int i = 0; i < 13; ++i) a[i] = static_cast<int>(test_rand(seed) % 6);
+        ok = tinystl::static_min_element<13>(a) == std::min_element(a, a + 13) &&
+            tinystl::static_max_element<13>(a) == std::max_element(a, a + 13) &&
+            tinystl::static_min_element<5>(a, tinystl::greater<int>()) == std::min_element(a, a + 5, std::greater<int>()) &&
+            tinystl::static_max_element<1>(a) == a;
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(sort_network, static_and_small_merges) {
+    uint32_t seed = 50;
+    int a[9], b[7], out[16], expect[16];
+    bool ok = true;
+    for (int round = 0; round < 500 && ok; ++round) {
+        for (int i = 0; i < 9; ++i) a[i] = static_cast<int>(test_rand(seed) % 20);
+        for (int i = 0; i < 7; ++i) b[i] = static_cast<int>(test_rand(seed) % 20);
+        std::sort(a, a + 9);
+        std::sort(b, b + 7);
+        std::merge(a, a + 9, b, b + 7, expect);
+        ok = tinystl::static_merge<9, 7>(a, b, out) == out + 16 && std::equal(out, out + 16, expect);
+        ok = ok && tinystl::static_merge<0, 7>(a, b, out) == out + 7 && std::equal(out, out + 7, b);
+        // runtime sizes below the threshold take the network merge, the vector one from 8 keys up
+        const size_t n1 = test_rand(seed) % 10, n2 = test_rand(seed) % 8;
+        std::merge(a, a + n1, b, b + n2, expect);
+        ok = ok && tinystl::merge(a, a + n1, b, b + n2, out) == out + n1 + n2 && std::equal(out, out + n1 + n2, expect);
+    }
+    EXPECT_TRUE(ok);
+
+    // keys equal to the vector padding
+    const int hi[] = { -5, 2147483647, 2147483647 }, lo[] = { -2147483647 - 1, 0, 2147483647, 2147483647, 2147483647 };
+    std::merge(hi, hi + 3, lo, lo + 5, expect);
+    EXPECT_TRUE(tinystl::merge(hi, hi + 3, lo, lo + 5, out) == out + 8 && std::equal(out, out + 8, expect));
+
+    // of equivalent keys the first range goes first
+    tagged x[4] = { { 1, 0 }, { 2, 1 }, { 2, 2 }, { 5, 3 } };
+    tagged y[3] = { { 2, 10 }, { 2, 11 }, { 4, 12 } };
+    tagged m[7];
+    tinystl::static_merge<4, 3>(x, y, m, tagged_less());
+    const int tags[] = { 0, 1, 2, 10, 11, 12, 3 };
+    ok = true;
+    for (int i = 0; i < 7; ++i) ok = ok && m[i].tag == tags[i];
+    EXPECT_TRUE(ok);
+}
+
+// radix_sort.h
+
+namespace {
+
+    struct radix_record {
+        unsigned short key;
+        int order;
+    };
+
+    struct radix_record_key {
+        unsigned short operator()(const radix_record& r) const { return r.key; }
+    };
+
+}
+
+TEST(radix_sort, integers_and_floats_match_std) {
+    std::vector<int> v = sort_pattern(0, 20000, 5), w = v;
+    tinystl::radix_sort(v.data(), v.data() + v.size());
+    std::sort(w.begin(), w.end());
+    EXPECT_TRUE(v == w);
+    std::vector<double> d(5000);
+    uint32_t x = 3;
+    for (size_t i = 0; i < d.size(); ++i) d[i] = (static_cast<int>(test_rand(x)) % 100000) / 7.0;
+    d[0] = -0.0;
+    d[1] = 0.0;
+    std::vector<double> e = d;
+    tinystl::radix_sort(d.data(), d.data() + d.size());
+    std::stable_sort(e.begin(), e.end());
+    EXPECT_TRUE(d == e);
+    std::vector<signed char> c(1000);
+    for (size_t i = 0; i < c.size(); ++i) c[i] = static_cast<signed char>(test_rand(x));
+    tinystl::radix_sort(c.data(), c.data() + c.size());
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+}
+
+TEST(radix_sort, bool_and_pair_keys) {
+    bool b[300];
+    for (int i = 0; i < 300; ++i) b[i] = (i * 7) % 3 == 0;
+    tinystl::radix_sort(b, b + 300);
+    EXPECT_TRUE(std::is_sorted(b, b + 300));
+    EXPECT_EQ(std::count(b, b + 300, true), 100);
+    std::vector<tinystl::pair<int, unsigned>> p;
+    uint32_t x = 11;
+    for (int i = 0; i < 3000; ++i) p.push_back(tinystl::pair<int, unsigned>(static_cast<int>(test_rand(x) % 50) - 25, test_rand(x)));
+    tinystl::radix_sort(p.data(), p.data() + p.size());
+    bool ok = true;
+    for (size_t i = 1; i < p.size(); ++i) ok = ok && !(p[i] < p[i - 1]);
+    EXPECT_TRUE(ok);
+}
+
+TEST(radix_sort, stable_by_key) {
+    std::vector<radix_record> v(10000);
+    uint32_t x = 17;
+    for (int i = 0; i < 10000; ++i) v[i].key = static_cast<unsigned short>(test_rand(x) % 300), v[i].order = i;
+    tinystl::radix_sort(v.data(), v.data() + v.size(), radix_record_key());
+    bool ok = true;
+    for (size_t i = 1; i < v.size(); ++i) ok = ok && (v[i - 1].key < v[i].key || (v[i - 1].key == v[i].key && v[i - 1].order < v[i].order));
+    EXPECT_TRUE(ok);
+}
+
+// top_k.h
+
+TEST(top_k, keeps_the_greatest_elements) {
+    const std::vector<int> v = sort_pattern(0, 100000, 23);
+    tinystl::top_k<int> top(100);
+    top.push(v.data(), v.data() + v.size());
+    EXPECT_TRUE(top.full());
+    std::vector<int> expect = v;
+    std::sort(expect.begin(), expect.end(), std::greater<int>());
+    EXPECT_EQ(top.top(), expect[99]);
+    std::vector<int> out(100);
+    EXPECT_TRUE(top.drain(out.data()) == out.data() + 100);
+    EXPECT_TRUE(top.empty());
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expect.begin()));
+
+    // fewer elements than k, k of zero, and a comparator making greatest the smallest
+    tinystl::top_k<int> few(10), none(0);
+    for (int i = 0; i < 4; ++i) { few.push(i); none.push(i); }
+    int out2[4];
+    EXPECT_TRUE(few.drain(out2) == out2 + 4 && out2[0] == 3 && out2[3] == 0);
+    EXPECT_TRUE(none.empty());
+    tinystl::top_k<int, tinystl::greater<int>> low(3);
+    low.push(v.data(), v.data() + v.size());
+    int out3[3];
+    low.drain(out3);
+    std::sort(expect.begin(), expect.end());
+    EXPECT_TRUE(std::equal(out3, out3 + 3, expect.begin()));
+}
+
+namespace {
+
+    // counts the live objects, to check what a container constructs and destroys
+    struct live_int {
+        static int live;
+        int v;
+        live_int(int x) : v(x) { ++live; }
+        live_int(const live_int& rhs) : v(rhs.v) { ++live; }
+        ~live_int() { --live; }
+        live_int& operator=(const live_int& rhs) { v = rhs.v; return *this; }
+        bool operator<(const live_int& rhs) const { return v < rhs.v; }
+    };
+    int live_int::live = 0;
+
+}
+
+TEST(top_k, destroys_what_it_keeps) {
+    {
+        tinystl::top_k<live_int> top(8);
+        for (int i = 0; i < 100; ++i) top.push(live_int(i));
+        EXPECT_EQ(live_int::live, 8);
+        EXPECT_EQ(top.top().v, 92);
+        top.clear();
+        EXPECT_EQ(live_int::live, 0);
+        top.push(live_int(5));
+    }
+    EXPECT_EQ(live_int::live, 0);
+}
+
+// merge.h, stable_sort
+
+TEST(merge, merge_and_inplace_merge_match_std) {
+    bool ok = true;
+    uint32_t x = 23;
+    for (int round = 0; round < 200; ++round) {
+        std::vector<int> a(test_rand(x) % 300), b(round % 7 == 0 ? 0 : test_rand(x) % 300);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<int>(test_rand(x) % 500);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<int>(test_rand(x) % (round % 2 ? 500 : 20));
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        std::vector<int> m(a.size() + b.size()), r(m.size());
+        tinystl::merge(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), m.data());
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), r.begin());
+        ok = ok && m == r;
+        std::vector<int> c(a);
+        c.insert(c.end(), b.begin(), b.end());
+        tinystl::inplace_merge(c.data(), c.data() + a.size(), c.data() + c.size());
+        ok = ok && c == r;
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(merge, stable_sort_keeps_equal_keys_in_order) {
+    bool ok = true;
+    for (int kind = 0; kind < 5; ++kind) {
+        std::vector<int> keys = sort_pattern(kind, 20000, 31 + kind);
+        std::vector<tinystl::pair<int, int>> v(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) v[i] = tinystl::pair<int, int>(keys[i] % 97, static_cast<int>(i));
+        std::vector<tinystl::pair<int, int>> w = v;
+        struct by_first {
+            bool operator()(const tinystl::pair<int, int>& l, const tinystl::pair<int, int>& r) const { return l.first < r.first; }
+        };
+        tinystl::stable_sort(v.data(), v.data() + v.size(), by_first());
+        std::stable_sort(w.begin(), w.end(), by_first());
+        ok = ok && v == w;
+    }
+    EXPECT_TRUE(ok);
+}
+
+namespace {
+
+    typedef tinystl::pair<const int*, const int*> int_run;
+
+    std::vector<int_run> make_runs(const std::vector<std::vector<int>>& runs) {
+        std::vector<int_run> r;
+        for (size_t i = 0; i < runs.size(); ++i) r.push_back(int_run(runs[i].data(), runs[i].data() + runs[i].size()));
+        return r;
+    }
+
+}
+
+TEST(merge, multiway_merge_matches_sorted_concatenation) {
+    bool ok = true;
+    const size_t counts[] = { 0, 1, 2, 3, 17, 256 };
+    for (size_t c = 0; c < 6; ++c) {
+        std::vector<std::vector<int>> runs(counts[c]);
+        std::vector<int> all;
+        uint32_t seed = 5 + static_cast<uint32_t>(c);
+        for (size_t i = 0; i < runs.size(); ++i) {
+            // empty and single element runs among the long ones
+            runs[i].resize(i % 5 == 1 ? 0 : i % 7 == 2 ? 1 : test_rand(seed) % 300);
+            for (size_t j = 0; j < runs[i].size(); ++j) runs[i][j] = static_cast<int>(test_rand(seed) % 1000);
+            std::sort(runs[i].begin(), runs[i].end());
+            all.insert(all.end(), runs[i].begin(), runs[i].end());
+        }
+        std::sort(all.begin(), all.end());
+        std::vector<int_run> r = make_runs(runs);
+        std::vector<int> out(all.size() + 1, -1);
+        int* end = tinystl::multiway_merge(r.data(), r.data() + r.size(), out.data());
+        ok = ok && end == out.data() + all.size() && out.back() == -1 && std::equal(all.begin(), all.end(), out.begin());
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(merge, multiway_merge_is_stable) {
+    // equal keys come out in run order
+    typedef tinystl::pair<int, int> item;
+    typedef tinystl::pair<const item*, const item*> item_run;
+    std::vector<std::vector<item>> runs(9);
+    for (int i = 0; i < 9; ++i) {
+        for (int k = 0; k < 50; ++k) runs[i].push_back(item(k / (i + 1), i));
+    }
+    std::vector<item_run> r;
+    for (size_t i = 0; i < runs.size(); ++i) r.push_back(item_run(runs[i].data(), runs[i].data() + runs[i].size()));
+    std::vector<item> out(450);
+    tinystl::multiway_merge(r.data(), r.data() + r.size(), out.data(), [](const item& a, const item& b) { return a.first < b.first; });
+    bool ok = true;
+    for (size_t i = 1; i < out.size(); ++i) {
+        ok = ok && (out[i - 1].first < out[i].first || (out[i - 1].first == out[i].first && out[i - 1].second <= out[i].second));
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(merge, multiway_set_union_keeps_largest_multiplicity) {
+    std::vector<std::vector<int>> runs(2);
+    uint32_t seed = 77;
+    for (int i = 0; i < 2; ++i) {
+        runs[i].resize(2000);
+        for (size_t j = 0; j < runs[i].size(); ++j) runs[i][j] = static_cast<int>(test_rand(seed) % 300);
+        std::sort(runs[i].begin(), runs[i].end());
+    }
+    std::vector<int> expect(4000);
+    expect.resize(std::set_union(runs[0].begin(), runs[0].end(), runs[1].begin(), runs[1].end(), expect.begin()) - expect.begin());
+    std::vector<int_run> r = make_runs(runs);
+    std::vector<int> out(4000);
+    out.resize(tinystl::multiway_set_union(r.data(), r.data() + 2, out.data()) - out.data());
+    EXPECT_TRUE(out == expect);
+
+    // several runs: every value as often as the run holding it most often
+    const int a[] = { 1, 1, 2, 5 }, b[] = { 1, 3, 5, 5, 5 }, c[] = { 0, 2, 2, 9 };
+    int_run r3[] = { int_run(a, a + 4), int_run(b, b + 5), int_run(c, c + 4) };
+    int out3[16];
+    const int want[] = { 0, 1, 1, 2, 2, 3, 5, 5, 5, 9 };
+    EXPECT_EQ(tinystl::multiway_set_union(r3, r3 + 3, out3) - out3, 10);
+    EXPECT_TRUE(std::equal(want, want + 10, out3));
+}
+
+// binary_search.h
+
+TEST(binary_search, bounds_match_std) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1, 2, 3, 63, 64, 65, 1000, 100000 };
+    for (size_t k = 0; k < 9; ++k) {
+        std::vector<int> v = sort_pattern(4, sizes[k], 3);
+        for (size_t i = 0; i < v.size(); ++i) v[i] = v[i] * 3 + static_cast<int>(i % 17) * 6;
+        std::sort(v.begin(), v.end());
+        const int* f = v.data();
+        const int* l = v.data() + v.size();
+        for (int key = -2; key < 110; ++key) {
+            const long lo = std::lower_bound(v.begin(), v.end(), key) - v.begin();
+            const long hi = std::upper_bound(v.begin(), v.end(), key) - v.begin();
+            ok = ok && tinystl::lower_bound(f, l, key) - f == lo && tinystl::upper_bound(f, l, key) - f == hi;
+            const tinystl::pair<const int*, const int*> r = tinystl::equal_range(f, l, key);
+            ok = ok && r.first - f == lo && r.second - f == hi && tinystl::binary_search(f, l, key) == (lo != hi);
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+// eytzinger_index.h
+
+TEST(eytzinger_index, lookups_match_std) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1, 2, 7, 8, 15, 16, 17, 1000, 65537 };
+    for (size_t s = 0; s < 10; ++s) {
+        std::vector<int> v = sort_pattern(0, sizes[s], 9 + static_cast<uint32_t>(s));
+        for (size_t i = 0; i < v.size(); ++i) v[i] = (v[i] & 0xffff) * 2;
+        const tinystl::eytzinger_index<int> index(v.data(), v.data() + v.size());
+        std::sort(v.begin(), v.end());
+        ok = ok && index.size() == v.size();
+        // the in order walk visits the keys sorted
+        size_t i = 0;
+        for (size_t k = index.first(); k != index.npos; k = index.next(k), ++i) ok = ok && i < v.size() && index[k] == v[i];
+        ok = ok && i == v.size();
+        uint32_t seed = 3;
+        for (int q = 0; q < 2000; ++q) {
+            const int key = static_cast<int>(test_rand(seed) % 0x20004) - 2;
+            std::vector<int>::iterator lo = std::lower_bound(v.begin(), v.end(), key);
+            std::vector<int>::iterator hi = std::upper_bound(v.begin(), v.end(), key);
+            const size_t a = index.lower_bound(key), b = index.upper_bound(key);
+            ok = ok && (lo == v.end() ? a == index.npos : a != index.npos && index[a] == *lo);
+            ok = ok && (hi == v.end() ? b == index.npos : b != index.npos && index[b] == *hi);
+            ok = ok && index.contains(key) == (lo != hi);
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+namespace {
+
+    // copies throw once the budget runs out, to check what a constructor leaves behind when one does
+    struct throwing_int : live_int {
+        static int budget;
+        throwing_int(int x) : live_int(x) {}
+        throwing_int(const throwing_int& rhs) : live_int(check(rhs)) {}
+        throwing_int& operator=(const throwing_int& rhs) { live_int::operator=(rhs); return *this; }
+        static const throwing_int& check(const throwing_int& rhs) {
+            if (budget-- == 0) throw std::runtime_error("copy");
+            return rhs;
+        }
+    };
+    int throwing_int::budget = -1;
+
+}
+
+TEST(eytzinger_index, throwing_copy_leaves_nothing) {
+    std::vector<throwing_int> v;
+    for (int i = 0; i < 100; ++i) v.push_back(throwing_int((i * 37) % 100));
+    const int before = live_int::live;
+    // the input is copied, the copy sorted, then moved into bfs order: fail in each step
+    const int budgets[] = { 50, 100, 200, 300 };
+    for (int k = 0; k < 4; ++k) {
+        throwing_int::budget = budgets[k];
+        EXPECT_THROW((tinystl::eytzinger_index<throwing_int>(v.data(), v.data() + v.size())), std::runtime_error);
+        EXPECT_EQ(live_int::live, before);
+    }
+    throwing_int::budget = -1;
+    {
+        tinystl::eytzinger_index<throwing_int> index(v.data(), v.data() + v.size());
+        EXPECT_EQ(index[index.first()].v, 0);
+        EXPECT_EQ(live_int::live, before + 100);
+    }
+    EXPECT_EQ(live_int::live, before);
+}
+
+// uninitialized.h
+
+TEST(uninitialized, failed_construction_rolls_back_and_rethrows) {
+    const int before = live_int::live;
+    std::vector<throwing_int> src;
+    for (int i = 0; i < 10; ++i) src.push_back(throwing_int(i));
+    throwing_int* p = tinystl::allocator<throwing_int>::allocate(10);
+    const int live = live_int::live;
+    // the sixth construction throws: the five built are destroyed and the exception reaches the caller
+    throwing_int::budget = 5;
+    EXPECT_THROW(tinystl::uninitialized_copy(src.data(), src.data() + 10, p), std::runtime_error);
+    EXPECT_EQ(live_int::live, live);
+    throwing_int::budget = 5;
+    EXPECT_THROW(tinystl::uninitialized_copy_n(src.data(), 10, p), std::runtime_error);
+    EXPECT_EQ(live_int::live, live);
+    throwing_int::budget = 5;
+    EXPECT_THROW(tinystl::uninitialized_fill(p, p + 10, src[0]), std::runtime_error);
+    EXPECT_EQ(live_int::live, live);
+    throwing_int::budget = 5;
+    EXPECT_THROW(tinystl::uninitialized_fill_n(p, 10, src[0]), std::runtime_error);
+    EXPECT_EQ(live_int::live, live);
+    throwing_int::budget = 5;
+    EXPECT_THROW(tinystl::uninitialized_move(src.data(), src.data() + 10, p), std::runtime_error);
+    EXPECT_EQ(live_int::live, live);
+    throwing_int::budget = 5;
+    EXPECT_THROW(tinystl::uninitialized_move_n(src.data(), 10, p), std::runtime_error);
+    EXPECT_EQ(live_int::live, live);
+    throwing_int::budget = -1;
+    throwing_int* end = tinystl::uninitialized_copy(src.data(), src.data() + 10, p);
+    EXPECT_TRUE(end == p + 10 && p[9].v == 9);
+    tinystl::destroy(p, end);
+    tinystl::allocator<throwing_int>::deallocate(p, 10);
+    src.clear();
+    EXPECT_EQ(live_int::live, before);
+}
+
+TEST(uninitialized, value_and_default_construct) {
+    int* p = tinystl::allocator<int>::allocate(1000);
+    std::fill(p, p + 1000, 5);
+    EXPECT_TRUE(tinystl::uninitialized_value_construct_n(p + 1, 998) == p + 999);
+    EXPECT_TRUE(p[0] == 5 && p[999] == 5 && std::count(p + 1, p + 999, 0) == 998);
+    // trivially default constructible elements are left as they are
+    std::fill(p, p + 1000, 5);
+    tinystl::uninitialized_default_construct(p, p + 1000);
+    EXPECT_EQ(std::count(p, p + 1000, 5), 1000);
+    tinystl::allocator<int>::deallocate(p, 1000);
+
+    // non trivial elements get their constructor, and a failure part way destroys what was built
+    const int before = live_int::live;
+    struct made : live_int { made() : live_int(7) {} };
+    made* q = tinystl::allocator<made>::allocate(10);
+    tinystl::uninitialized_value_construct(q, q + 10);
+    EXPECT_TRUE(live_int::live == before + 10 && q[9].v == 7);
+    tinystl::destroy(q, q + 10);
+    tinystl::uninitialized_default_construct_n(q, 10);
+    EXPECT_EQ(live_int::live, before + 10);
+    tinystl::destroy(q, q + 10);
+    tinystl::allocator<made>::deallocate(q, 10);
+    EXPECT_EQ(live_int::live, before);
+}
+
+#if defined(__linux__)
+TEST(uninitialized, zero_pages_only_for_private_anonymous_memory) {
+    // a shared mapping reads its old contents back once its pages are dropped, so it has to be zero filled
+    const size_t bytes = static_cast<size_t>(32) << 20;
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const int flags[] = { MAP_PRIVATE | MAP_ANONYMOUS, MAP_SHARED | MAP_ANONYMOUS };
+    for (int k = 0; k < 2; ++k) {
+        void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags[k], -1, 0);
+        EXPECT_TRUE(map != MAP_FAILED);
+        if (map == MAP_FAILED) continue;
+        int* v = static_cast<int*>(map);
+        const size_t n = bytes / sizeof(int);
+        std::fill(v, v + n, -1);
+        // misaligned at both ends, so the partial pages are zero filled around the dropped ones
+        EXPECT_TRUE(tinystl::uninitialized_value_construct_n(v + 3, n - 6) == v + n - 3);
+        bool ok = v[2] == -1 && v[n - 3] == -1;
+        for (size_t i = 3; ok && i < n - 3; i += 97) ok = v[i] == 0;
+        ok = ok && v[3] == 0 && v[n - 4] == 0 && v[page / sizeof(int)] == 0;
+        EXPECT_TRUE(ok);
+        munmap(map, bytes);
+    }
+}
+
+#ifdef MADV_WIPEONFORK
+TEST(uninitialized, zero_pages_keep_the_mapping_flags) {
+    // a buffer the caller marked wipe on fork stays marked: a child still sees zeros where the parent wrote
+    const size_t bytes = static_cast<size_t>(32) << 20;
+    void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    EXPECT_TRUE(map != MAP_FAILED);
+    if (map == MAP_FAILED) return;
+    EXPECT_EQ(madvise(map, bytes, MADV_WIPEONFORK), 0);
+    int* v = static_cast<int*>(map);
+    const size_t n = bytes / sizeof(int);
+    tinystl::uninitialized_value_construct_n(v, n);
+    v[0] = 7;
+    v[n - 1] = 7;
+    const pid_t child = fork();
+    if (child == 0) _exit(v[0] == 0 && v[n - 1] == 0 ? 0 : 1);
+    int status = -1;
+    EXPECT_TRUE(child > 0 && waitpid(child, &status, 0) == child);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_TRUE(v[0] == 7 && v[1] == 0);
+    munmap(map, bytes);
+}
+#endif
+#endif
+
+// views.h
+
+TEST(views, pipelines_match_loops) {
+    uint32_t seed = 49;
+    std::vector<int> v(1000);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(test_rand(seed) % 100);
+    tinystl::subrange<int*> src(v.data(), v.data() + v.size());
+
+    std::vector<long> expect;
+    for (size_t i = 0; i < v.size() && expect.size() < 50; ++i)
+        if (v[i] % 3 == 0) expect.push_back(static_cast<long>(v[i]) * v[i]);
+    std::vector<long> out(100, -1);
+    long* end = tinystl::copy(src | tinystl::views::filter([](int x) { return x % 3 == 0; })
+        | tinystl::views::transform([](int x) { return static_cast<long>(x) * x; }) | tinystl::views::take(50), out.data());
+    EXPECT_EQ(end - out.data(), static_cast<ptrdiff_t>(expect.size()));
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), out.data()));
+
+    // drop then chunk: every chunk holds three elements but the last
+    auto chunks = src | tinystl::views::drop(10) | tinystl::views::chunk(3);
+    size_t at = 10, count = 0;
+    bool ok = true;
+    for (auto c : chunks) {
+        const size_t len = std::min<size_t>(3, v.size() - at);
+        ok = ok && static_cast<size_t>(c.size()) == len && c.begin() == v.data() + at;
+        at += len;
+        ++count;
+    }
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(count, (v.size() - 10 + 2) / 3);
+
+    // zip stops at the shorter range
+    int a[] = { 1, 2, 3, 4, 5 };
+    long b[] = { 10, 20, 30 };
+    long sum = 0;
+    for (auto p : tinystl::views::zip(a, b)) sum += p.first * p.second;
+    EXPECT_EQ(sum, 10 + 40 + 90);
+}
+
+TEST(views, negative_and_out_of_range_counts) {
+    int a[] = { 1, 2, 3, 4, 5 };
+    EXPECT_EQ(tinystl::views::drop(a, -3).begin(), a);
+    EXPECT_EQ(tinystl::views::drop(a, -3).end(), a + 5);
+    EXPECT_EQ(tinystl::views::drop(a, 9).begin(), a + 5);
+    EXPECT_EQ(tinystl::views::take(a, -3).begin(), tinystl::views::take(a, -3).end());
+    // a filter view is forward, so drop steps instead of jumping
+    auto odd = tinystl::views::filter(a, [](int x) { return x % 2 != 0; });
+    EXPECT_EQ(*tinystl::views::drop(odd, -1).begin(), 1);
+    EXPECT_EQ(*tinystl::views::drop(odd, 1).begin(), 3);
+    EXPECT_THROW(tinystl::views::chunk(a, 0), std::out_of_range);
+    EXPECT_THROW(tinystl::views::chunk(-2), std::out_of_range);
+}
+
+TEST(views, categories_and_reduce) {
+    // the categories follow the traversal each adaptor implements, computed elements or not
+    auto square = [](int x) { return static_cast<long>(x) * x; };
+    typedef decltype(tinystl::views::transform(std::declval<int (&)[4]>(), square).begin()) transformed;
+    EXPECT_TRUE((std::is_same<tinystl::iterator_traits<transformed>::iterator_category, tinystl::random_access_iterator_tag>::value));
+    typedef decltype(tinystl::views::zip(std::declval<int (&)[4]>(), std::declval<long (&)[4]>()).begin()) zipped;
+    EXPECT_TRUE((std::is_same<tinystl::iterator_traits<zipped>::iterator_category, tinystl::random_access_iterator_tag>::value));
+    typedef decltype(tinystl::views::chunk(std::declval<int (&)[4]>(), 2).begin()) chunked;
+    EXPECT_TRUE((std::is_same<tinystl::iterator_traits<chunked>::iterator_category, tinystl::forward_iterator_tag>::value));
+    // so a take of a transform is cut directly and keeps its size in constant time
+    int b[] = { 1, 2, 3, 4, 5 };
+    auto head = tinystl::views::transform(b, square) | tinystl::views::take(3);
+    EXPECT_TRUE((std::is_same<decltype(head.begin()), transformed>::value));
+    EXPECT_EQ(head.size(), 3);
+    EXPECT_EQ(head[2], 9);
+
+    // the lambda holding iterator is still assignable
+    int a[] = { 1, 2, 3, 4 };
+    auto it = tinystl::views::transform(a, square).begin();
+    it = tinystl::views::transform(a, square).end();
+    EXPECT_TRUE(it == tinystl::views::transform(a, square).end());
+
+    uint32_t seed = 49;
+    std::vector<int> v(100000);
+    for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(test_rand(seed) % 1000);
+    tinystl::subrange<int*> src(v.data(), v.data() + v.size());
+    long expect = 0;
+    for (size_t i = 0; i < v.size(); ++i) expect += static_cast<long>(v[i]) * v[i];
+    EXPECT_EQ(tinystl::reduce(src | tinystl::views::transform(square), 0L), expect);
+    EXPECT_EQ(tinystl::reduce(src | tinystl::views::transform(square)), expect);
+    EXPECT_EQ(tinystl::accumulate(src | tinystl::views::transform(square), 0L), expect);
+}
+
+TEST(views, heap_sinks_on_a_prefix) {
+    uint32_t seed = 49;
+    int a[200];
+    for (int i = 0; i < 200; ++i) a[i] = static_cast<int>(test_rand(seed) % 1000);
+    std::vector<int> expect(a, a + 100);
+    std::sort(expect.begin(), expect.end());
+    auto prefix = tinystl::views::take(a, 100);
+    tinystl::make_heap(prefix);
+    tinystl::sort_heap(prefix);
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), a));
+}
+
+// thread_pool.h
+
+namespace {
+
+    long pool_fib(tinystl::thread_pool& pool, int n) {
+        if (n < 12) return n < 2 ? n : pool_fib(pool, n - 1) + pool_fib(pool, n - 2);
+        long a = 0, b = 0;
+        pool.invoke([&]() { a = pool_fib(pool, n - 1); }, [&]() { b = pool_fib(pool, n - 2); });
+        return a + b;
+    }
+
+}
+
+TEST(thread_pool, parallel_for_visits_every_index_once) {
+    tinystl::thread_pool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+    std::vector<std::atomic<int>> hits(100000);
+    for (size_t i = 0; i < hits.size(); ++i) hits[i].store(0);
+    pool.parallel_for(size_t(0), hits.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) hits[i].fetch_add(1);
+    }, 64);
+    bool once = true;
+    for (size_t i = 0; i < hits.size(); ++i) once = once && hits[i].load() == 1;
+    EXPECT_TRUE(once);
+}
+
+TEST(thread_pool, nested_invoke_and_exceptions) {
+    tinystl::thread_pool pool(4);
+    EXPECT_EQ(pool_fib(pool, 25), 75025L);
+    EXPECT_THROW(pool.invoke([]() {}, []() { throw std::runtime_error("right"); }), std::runtime_error);
+    EXPECT_THROW(pool.invoke([]() { throw std::logic_error("left"); }, []() {}), std::logic_error);
+    // the pool is still usable after a failed region
+    EXPECT_EQ(pool_fib(pool, 20), 6765L);
+}
+
+TEST(thread_pool, regions_from_several_threads) {
+    tinystl::thread_pool pool(3);
+    std::atomic<long> total(0);
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t) {
+        callers.push_back(std::thread([&]() {
+            pool.parallel_for(0, 10000, [&](int first, int last) { total.fetch_add(last - first); });
+        }));
+    }
+    for (size_t t = 0; t < callers.size(); ++t) callers[t].join();
+    EXPECT_EQ(total.load(), 40000L);
+}
+
+// execution.h
+
+TEST(execution, parallel_copy_fill_equal) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1000, 100000, 1000003 };
+    for (size_t k = 0; k < 4; ++k) {
+        const size_t n = sizes[k];
+        std::vector<int> src(n), dst(n + 1, -1);
+        for (size_t i = 0; i < n; ++i) src[i] = static_cast<int>(i * 7);
+        int* end = tinystl::copy(tinystl::execution::par, src.data(), src.data() + n, dst.data());
+        ok = ok && end == dst.data() + n && dst[n] == -1 && std::equal(src.begin(), src.end(), dst.begin());
+        ok = ok && tinystl::equal(tinystl::execution::par, src.data(), src.data() + n, dst.data());
+        if (n > 0) {
+            dst[n / 3] ^= 1;
+            ok = ok && !tinystl::equal(tinystl::execution::par_unseq, src.data(), src.data() + n, dst.data());
+        }
+        tinystl::fill(tinystl::execution::par, dst.data(), dst.data() + n, 9);
+        ok = ok && std::count(dst.begin(), dst.end(), 9) == static_cast<long>(n) && dst[n] == -1;
+        tinystl::fill_n(tinystl::execution::seq, dst.data(), n, 4);
+        ok = ok && std::count(dst.begin(), dst.end(), 4) == static_cast<long>(n);
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(execution, parallel_uninitialized_construction) {
+    const size_t n = 300000;
+    tinystl::pair<int, int>* p = tinystl::allocator<tinystl::pair<int, int>>::allocate(n);
+    tinystl::uninitialized_fill_n(tinystl::execution::par, p, n, tinystl::pair<int, int>(1, 2));
+    bool ok = true;
+    for (size_t i = 0; i < n; ++i) ok = ok && p[i].first == 1 && p[i].second == 2;
+    std::vector<long> src(n, 5);
+    long* q = tinystl::allocator<long>::allocate(n);
+    tinystl::uninitialized_copy(tinystl::execution::par, src.data(), src.data() + n, q);
+    ok = ok && std::equal(src.begin(), src.end(), q);
+    EXPECT_TRUE(ok);
+    tinystl::destroy(p, p + n);
+    tinystl::allocator<tinystl::pair<int, int>>::deallocate(p, n);
+    tinystl::allocator<long>::deallocate(q, n);
+}
+
+TEST(execution, blocks_open_on_destination_boundaries) {
+    // 12 byte records from an address off any boundary: every block but the first opens at the first
+    // record on or after a parallel_block_bytes boundary, and the blocks cover the range once
+    struct record { int a, b, c; };
+    const size_t n = 200000, bytes = tinystl::parallel_block_bytes;
+    std::vector<char> buf(n * sizeof(record) + 64);
+    record* dst = reinterpret_cast<record*>(buf.data() + 4);
+    std::mutex m;
+    std::vector<std::pair<size_t, size_t>> seen;
+    EXPECT_TRUE(tinystl::parallel_dest_blocks(n, dst, [&](size_t lo, size_t hi) {
+        std::lock_guard<std::mutex> lock(m);
+        seen.push_back(std::make_pair(lo, hi));
+    }));
+    std::sort(seen.begin(), seen.end());
+    const uintptr_t base = reinterpret_cast<uintptr_t>(dst);
+    bool ok = !seen.empty() && seen.front().first == 0 && seen.back().second == n;
+    for (size_t k = 0; ok && k < seen.size(); ++k) {
+        ok = seen[k].first < seen[k].second && (k == 0 || seen[k].first == seen[k - 1].second);
+        // a run of blocks opens on the first record whose start passes a boundary
+        const uintptr_t at = base + seen[k].first * sizeof(record);
+        ok = ok && (k == 0 || (at - sizeof(record)) / bytes < at / bytes);
+    }
+    EXPECT_TRUE(ok);
+
+    std::vector<record> src(n);
+    for (size_t i = 0; i < n; ++i) src[i] = record{ static_cast<int>(i), static_cast<int>(2 * i), static_cast<int>(3 * i) };
+    tinystl::copy(tinystl::execution::par, src.data(), src.data() + n, dst);
+    ok = true;
+    for (size_t i = 0; ok && i < n; ++i) ok = dst[i].a == src[i].a && dst[i].b == src[i].b && dst[i].c == src[i].c;
+    EXPECT_TRUE(ok);
+}
+
+// set_algo.h
+
+namespace {
+
+    template <class T>
+    std::vector<T> sorted_keys(size_t n, uint32_t range, uint32_t seed) {
+        std::vector<T> v(n);
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<T>(test_rand(seed) % range);
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    // the integer kernels against std for every size ratio, duplicates included
+    template <class T>
+    bool intersection_matches_std(uint32_t range) {
+        const size_t sizes[] = { 0, 1, 3, 7, 8, 9, 33, 100, 1000, 50000 };
+        bool ok = true;
+        for (size_t x = 0; x < 10; ++x) {
+            for (size_t y = 0; y < 10; ++y) {
+                const std::vector<T> a = sorted_keys<T>(sizes[x], range, 3 + static_cast<uint32_t>(x));
+                const std::vector<T> b = sorted_keys<T>(sizes[y], range, 101 + static_cast<uint32_t>(y));
+                std::vector<T> expect(a.size() + b.size());
+                expect.resize(std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), expect.begin()) - expect.begin());
+                std::vector<T> out(expect.size() + 1, T(7));
+                T* end = tinystl::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data());
+                ok = ok && end == out.data() + expect.size() && out.back() == T(7) && std::equal(expect.begin(), expect.end(), out.begin());
+                end = tinystl::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data(), tinystl::less<T>());
+                ok = ok && end == out.data() + expect.size() && std::equal(expect.begin(), expect.end(), out.begin());
+            }
+        }
+        return ok;
+    }
+
+}
+
+TEST(set_algo, integer_intersection_matches_std) {
+    EXPECT_TRUE(intersection_matches_std<uint32_t>(1u << 31));
+    EXPECT_TRUE(intersection_matches_std<uint32_t>(200));
+    EXPECT_TRUE(intersection_matches_std<int>(5));
+    EXPECT_TRUE(intersection_matches_std<int64_t>(300));
+    EXPECT_TRUE(intersection_matches_std<uint64_t>(1u << 31));
+}
+
+TEST(set_algo, intersection_extreme_keys) {
+    // the kernels compare in the signedness of the key type
+    const int64_t a[] = { INT64_MIN, -5, -1, 0, 3, INT64_MAX };
+    const int64_t b[] = { INT64_MIN, -1, 3, 4, INT64_MAX };
+    int64_t out[6];
+    const int64_t expect[] = { INT64_MIN, -1, 3, INT64_MAX };
+    EXPECT_EQ(tinystl::set_intersection(a, a + 6, b, b + 5, out) - out, 4);
+    EXPECT_TRUE(std::equal(expect, expect + 4, out));
+    const uint32_t c[] = { 0, 1, 0x80000000u, 0xffffffffu };
+    const uint32_t d[] = { 1, 0x7fffffffu, 0x80000000u, 0xffffffffu };
+    uint32_t out2[4];
+    EXPECT_EQ(tinystl::set_intersection(c, c + 4, d, d + 4, out2) - out2, 3);
+    EXPECT_TRUE(out2[0] == 1 && out2[1] == 0x80000000u && out2[2] == 0xffffffffu);
+}
+
+// numeric.h
+
+TEST(numeric, folds_match_serial_loops) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1, 7, 8, 9, 1000, 300001 };
+    for (size_t k = 0; k < 7; ++k) {
+        const size_t n = sizes[k];
+        std::vector<int> a(n), b(n);
+        std::vector<unsigned> u(n);
+        uint32_t seed = 31 + static_cast<uint32_t>(k);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<int>(test_rand(seed) % 2001) - 1000;
+            b[i] = static_cast<int>(test_rand(seed) % 7) - 3;
+            u[i] = test_rand(seed);
+        }
+        long long sum = 3, dot = 0, sq = 0;
+        unsigned prod = 1u;
+        int lo = 1 << 30, diff = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += a[i]; dot += static_cast<long long>(a[i]) * b[i]; sq += static_cast<long long>(a[i]) * a[i];
+            prod *= u[i] | 1u; lo = a[i] < lo ? a[i] : lo; diff -= a[i];
+        }
+        const int* f = a.data();
+        const int* l = a.data() + n;
+        for (size_t i = 0; i < n; ++i) u[i] |= 1u;
+        ok = ok && tinystl::accumulate(f, l, 3LL) == sum && tinystl::reduce(f, l, 3LL) == sum;
+        ok = ok && tinystl::reduce(tinystl::execution::par, f, l, 3LL) == sum;
+        ok = ok && tinystl::reduce(tinystl::execution::par, u.data(), u.data() + n, 1u, tinystl::multiplies<unsigned>()) == prod;
+        ok = ok && tinystl::reduce(tinystl::execution::par, f, l, 1 << 30, tinystl::minimum<int>()) == lo;
+        ok = ok && tinystl::inner_product(f, l, b.data(), 0LL) == dot;
+        ok = ok && tinystl::transform_reduce(tinystl::execution::par, f, l, b.data(), 0LL) == dot;
+        ok = ok && tinystl::transform_reduce(tinystl::execution::par, f, l, 0LL, tinystl::plus<long long>(),
+            [](int x) { return static_cast<long long>(x) * x; }) == sq;
+        // an operator that is not associative keeps the left fold
+        ok = ok && tinystl::reduce(tinystl::execution::par, f, l, 0, tinystl::minus<int>()) == diff;
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(numeric, scans_match_serial_loops) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1, 1000, 300001 };
+    for (size_t k = 0; k < 4; ++k) {
+        const size_t n = sizes[k];
+        std::vector<long long> a(n), inc(n), exc(n);
+        uint32_t seed = 57 + static_cast<uint32_t>(k);
+        for (size_t i = 0; i < n; ++i) a[i] = static_cast<long long>(test_rand(seed) % 1000) - 500;
+        long long run = 10;
+        for (size_t i = 0; i < n; ++i) { exc[i] = run; run += a[i]; inc[i] = run; }
+        std::vector<long long> out(n + 1, -1);
+        long long* end = tinystl::inclusive_scan(tinystl::execution::par, a.data(), a.data() + n, out.data(), tinystl::plus<long long>(), 10LL);
+        ok = ok && end == out.data() + n && out[n] == -1 && std::equal(inc.begin(), inc.end(), out.begin());
+        tinystl::exclusive_scan(tinystl::execution::par, a.data(), a.data() + n, out.data(), 10LL);
+        ok = ok && std::equal(exc.begin(), exc.end(), out.begin());
+        tinystl::inclusive_scan(a.data(), a.data() + n, out.data(), tinystl::plus<long long>(), 10LL);
+        ok = ok && std::equal(inc.begin(), inc.end(), out.begin());
+        // in place, without an initial value
+        std::vector<long long> c = a;
+        tinystl::inclusive_scan(tinystl::execution::par, c.data(), c.data() + n, c.data());
+        for (size_t i = 0; i < n; ++i) ok = ok && c[i] == inc[i] - 10;
+        c = a;
+        tinystl::exclusive_scan(tinystl::execution::par, c.data(), c.data() + n, c.data(), 10LL);
+        ok = ok && c == exc;
+    }
+    EXPECT_TRUE(ok);
+}
+
+// parallel_set_algo.h
+
+namespace {
+
+    // sorted keys drawn from [0, range), so small ranges repeat keys across many pieces
+    std::vector<int> set_input(size_t n, int range, uint32_t seed) {
+        std::vector<int> v(n);
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(test_rand(seed) % static_cast<uint32_t>(range));
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    // the result of op with a policy matches std_op, and nothing is written past its end
+    template <class Op, class StdOp>
+    bool set_matches_std(const std::vector<int>& a, const std::vector<int>& b, Op op, StdOp std_op) {
+        std::vector<int> expect(a.size() + b.size());
+        expect.resize(std_op(a.begin(), a.end(), b.begin(), b.end(), expect.begin()) - expect.begin());
+        std::vector<int> out(expect.size() + 1, -1);
+        int* end = op(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), out.data());
+        return end == out.data() + expect.size() && out.back() == -1 && std::equal(expect.begin(), expect.end(), out.begin());
+    }
+
+}
+
+TEST(parallel_set_algo, matches_std) {
+    bool ok = true;
+    const size_t sizes[] = { 0, 1000, 200000 };
+    const int ranges[] = { 3, 1000, 1 << 30 };
+    for (size_t s = 0; s < 3; ++s) {
+        for (size_t r = 0; r < 3; ++r) {
+            const std::vector<int> a = set_input(sizes[s], ranges[r], 11 + static_cast<uint32_t>(r));
+            const std::vector<int> b = set_input(sizes[2 - s] / 2 + 7, ranges[r], 97 + static_cast<uint32_t>(s));
+            typedef std::vector<int>::const_iterator in_iter;
+            typedef std::vector<int>::iterator out_iter;
+            ok = ok && set_matches_std(a, b,
+                [](const int* f1, const int* l1, const int* f2, const int* l2, int* o) { return tinystl::set_union(tinystl::execution::par, f1, l1, f2, l2, o); },
+                [](in_iter f1, in_iter l1, in_iter f2, in_iter l2, out_iter o) { return std::set_union(f1, l1, f2, l2, o); });
+            ok = ok && set_matches_std(a, b,
+                [](const int* f1, const int* l1, const int* f2, const int* l2, int* o) { return tinystl::set_intersection(tinystl::execution::par, f1, l1, f2, l2, o); },
+                [](in_iter f1, in_iter l1, in_iter f2, in_iter l2, out_iter o) { return std::set_intersection(f1, l1, f2, l2, o); });
+            ok = ok && set_matches_std(a, b,
+                [](const int* f1, const int* l1, const int* f2, const int* l2, int* o) { return tinystl::set_difference(tinystl::execution::par, f1, l1, f2, l2, o); },
+                [](in_iter f1, in_iter l1, in_iter f2, in_iter l2, out_iter o) { return std::set_difference(f1, l1, f2, l2, o); });
+            ok = ok && set_matches_std(a, b,
+                [](const int* f1, const int* l1, const int* f2, const int* l2, int* o) { return tinystl::set_symmetric_difference(tinystl::execution::par, f1, l1, f2, l2, o); },
+                [](in_iter f1, in_iter l1, in_iter f2, in_iter l2, out_iter o) { return std::set_symmetric_difference(f1, l1, f2, l2, o); });
+        }
+    }
+    EXPECT_TRUE(ok);
+}
+
+TEST(parallel_set_algo, comparator_and_non_trivial_output) {
+    // descending keys, written into a type the scratch buffer has to construct
+    struct boxed {
+        int v;
+        boxed() : v(-1) {}
+        boxed(int x) : v(x) {}
+    };
+    const size_t n = 100000;
+    std::vector<int> a = set_input(n, 5000, 3), b = set_input(n, 5000, 5);
+    std::reverse(a.begin(), a.end());
+    std::reverse(b.begin(), b.end());
+    std::vector<int> expect(2 * n);
+    expect.resize(std::set_union(a.begin(), a.end(), b.begin(), b.end(), expect.begin(), std::greater<int>()) - expect.begin());
+    std::vector<boxed> out(2 * n);
+    boxed* end = tinystl::set_union(tinystl::execution::par, a.data(), a.data() + n, b.data(), b.data() + n, out.data(), tinystl::greater<int>());
+    bool ok = end == out.data() + expect.size() && end->v == -1;
+    for (size_t i = 0; ok && i < expect.size(); ++i) ok = out[i].v == expect[i];
+    EXPECT_TRUE(ok);
+}
+
+int main() {
+    return tinystl::test::run_all_tests() == 0 ? 0 : 1;
 }
@@ -0,0 +1,78 @@
+#ifndef TINYSTL_TEST_H_
+#define TINYSTL_TEST_H_
+
+// a minimal test harness: TEST defines a case and registers it in definition order,
+// a failed EXPECT_* reports the expression and the case carries on
+
+#include <cstdio>
+
+namespace tinystl {
+namespace test {
+
+    struct test_case {
+        const char* name;
+        void (*run)();
+        test_case* next;
+    };
+
+    struct test_registry {
+        test_case* head;
+        test_case* tail;
+        int failures;
+    };
+
+    inline test_registry& registry() {
+        static test_registry r = { nullptr, nullptr, 0 };
+        return r;
+    }
+
+    struct test_registrar {
+        explicit test_registrar(test_case* c) {
+            test_registry& r = registry();
+            if (r.tail) r.tail->next = c;
+            else r.head = c;
+            r.tail = c;
+        }
+    };
+
+    inline void expect_failed(const char* file, int line, const char* expr) {
+        std::printf("%s:%d: expected %s\n", file, line, expr);
+        ++registry().failures;
+    }
+
+    // runs every case, returns the number of failed ones
+    inline int run_all_tests() {
+        int cases = 0, failed = 0;
+        for (test_case* c = registry().head; c != nullptr; c = c->next, ++cases) {
+            const int before = registry().failures;
+            c->run();
+            const bool ok = registry().failures == before;
+            if (!ok) ++failed;
+            std::printf("[%s] %s\n", ok ? "  OK  " : "FAILED", c->name);
+        }
+        std::printf("%d of %d cases passed\n", cases - failed, cases);
+        return failed;
+    }
+
+}
+}
+
+#define TEST(group, name) \
+    static void group##_##name##_test(); \
+    static tinystl::test::test_case group##_##name##_case = { #group "." #name, group##_##name##_test, nullptr }; \
+    static tinystl::test::test_registrar group##_##name##_registrar(&group##_##name##_case); \
+    static void group##_##name##_test()
+
+#define EXPECT_TRUE(cond) \
+    do { if (!(cond)) tinystl::test::expect_failed(__FILE__, __LINE__, #cond); } while (0)
+#define EXPECT_FALSE(cond) EXPECT_TRUE(!(cond))
+#define EXPECT_EQ(lhs, rhs) EXPECT_TRUE((lhs) == (rhs))
+#define EXPECT_NE(lhs, rhs) EXPECT_TRUE((lhs) != (rhs))
+#define EXPECT_THROW(stmt, exception) \
+    do { \
+        bool thrown = false; \
+        try { stmt; } catch (const exception&) { thrown = true; } \
+        if (!thrown) tinystl::test::expect_failed(__FILE__, __LINE__, #stmt " throws " #exception); \
+    } while (0)
+
+#endif //TINYSTL_TEST_H_
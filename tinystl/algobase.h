@@ -4,6 +4,7 @@
 #include <cstring>
 
 #include "iterator.h"
+#include "simd.h"
 #include "util.h"
 
 namespace tinystl {
@@ -27,9 +28,19 @@ namespace tinystl {
     template <class T, class Compare>
     const T& min(const T& lhs, const T& rhs, Compare comp) { return comp(rhs, lhs) ? rhs : lhs; }
 
-    // iterator swap
+    // raw pointer ranges whose elements compare equal exactly when their bytes do
+    template <class Tp, class Up>
+    struct bitwise_comparable_ptr : public bool_constant<std::is_same<typename std::remove_const<Tp>::type, typename std::remove_const<Up>::type>::value &&
+        is_bitwise_comparable<typename std::remove_const<Tp>::type>::value> {};
+
+    // iterator swap: a proxy reference is a prvalue, its swap is found by argument dependent lookup
+    // where the iterator is used, so it need not be declared before this header
+    template <class FIter1, class FIter2>
+    void iter_swap_aux(FIter1 lhs, FIter2 rhs, std::true_type) { tinystl::swap(*lhs, *rhs); }
+    template <class FIter1, class FIter2>
+    void iter_swap_aux(FIter1 lhs, FIter2 rhs, std::false_type) { swap(*lhs, *rhs); }
     template <class FIter1, class FIter2>
-    void iter_swap(FIter1 lhs, FIter2 rhs) { tinystl::swap(*lhs, *rhs); }
+    void iter_swap(FIter1 lhs, FIter2 rhs) { tinystl::iter_swap_aux(lhs, rhs, std::is_lvalue_reference<decltype(*lhs)>()); }
 
     // copy
     template <class InputIter, class OutputIter>
@@ -48,11 +59,13 @@ namespace tinystl {
     typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value, Up*>::type
     unchecked_copy(Tp* first, Tp* last, Up* result) {
         const auto n = static_cast<size_t>(last - first);
-        if (n != 0) std::memmove(result, first, n * sizeof(Up));
+        tinystl::simd_copy(result, first, n * sizeof(Up));
         return result + n;
     }
     template <class InputIter, class OutputIter>
-    OutputIter copy(InputIter first, InputIter last, OutputIter result) { return unchecked_copy(first, last, result); }
+    OutputIter copy(InputIter first, InputIter last, OutputIter result) {
+        return tinystl::rewrap_iter(result, unchecked_copy(tinystl::unwrap_iter(first), tinystl::unwrap_iter(last), tinystl::unwrap_iter(result)));
+    }
 
     // copy backward
     template <class BidirectionalIter1, class BidirectionalIter2>
@@ -71,19 +84,174 @@ namespace tinystl {
     typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value, Up*>::type
     unchecked_copy_backward(Tp* first, Tp* last, Up* result) {
         const auto n = static_cast<size_t>(last - first);
-        if ( n != 0 ) { result -= n; std::memmove(result, first, n * sizeof(Up)); }
+        result -= n;
+        tinystl::simd_copy(result, first, n * sizeof(Up));
         return result;
     }
     template <class BidirectionalIter1, class BidirectionalIter2>
     BidirectionalIter2 copy_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
-        return unchecked_copy_backward(first, last, result);
+        return tinystl::rewrap_iter(result, unchecked_copy_backward(tinystl::unwrap_iter(first), tinystl::unwrap_iter(last), tinystl::unwrap_iter(result)));
     }
 
+    // chunk masks for simd_compact: the loops have no branches, so simple predicates on arithmetic
+    // elements vectorise, and the predicate is still applied exactly once per element in order
+    template <class T, class UnaryPredicate, bool Keep>
+    struct compact_if {
+        UnaryPredicate& pred;
+        explicit compact_if(UnaryPredicate& p) : pred(p) {}
+        uint64_t operator()(const T* p, size_t count) {
+            uint64_t m = 0;
+            for (size_t k = 0; k < count; ++k) m |= static_cast<uint64_t>(static_cast<bool>(pred(p[k])) == Keep) << k;
+            return m;
+        }
+    };
+
+    // an element is kept when it differs from its predecessor; the last element of a chunk is carried
+    // over since compacting in place may overwrite it
+    template <class T>
+    struct compact_unique {
+        T prev;
+        explicit compact_unique(const T& first) : prev(first) {}
+        uint64_t operator()(const T* p, size_t count) {
+            uint64_t m = static_cast<uint64_t>(!(prev == p[0]));
+            for (size_t k = 1; k < count; ++k) m |= static_cast<uint64_t>(!(p[k - 1] == p[k])) << k;
+            prev = p[count - 1];
+            return m;
+        }
+    };
+
     // copy if unary_pred
     template <class InputIter, class OutputIter, class UnaryPredicate>
     OutputIter copy_if(InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred) {
         for (; first != last; ++first) { if (unary_pred(*first)) *result++ = *first; } return result;
     }
+    // arithmetic elements are compacted into a stack buffer, since the output only has room for the survivors
+    template <class Tp, class Up, class UnaryPredicate>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_arithmetic<Up>::value, Up*>::type
+    copy_if(Tp* first, Tp* last, Up* result, UnaryPredicate unary_pred) {
+        const size_t chunk = 16 * simd_compact_chunk;
+        alignas(64) Up buf[chunk];
+        compact_if<Up, UnaryPredicate, true> keep(unary_pred);
+        for (size_t n = static_cast<size_t>(last - first); n > 0;) {
+            const size_t count = n < chunk ? n : chunk;
+            const size_t kept = tinystl::simd_compact(first, count, buf, keep);
+            if (kept != 0) std::memcpy(result, buf, kept * sizeof(Up));
+            result += kept;
+            first += count;
+            n -= count;
+        }
+        return result;
+    }
+
+    // remove if unary_pred
+    template <class ForwardIter, class UnaryPredicate>
+    ForwardIter remove_if(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        for (; first != last && !unary_pred(*first); ++first) {}
+        if (first == last) return first;
+        ForwardIter result = first;
+        for (++first; first != last; ++first) { if (!unary_pred(*first)) { *result = tinystl::move(*first); ++result; } }
+        return result;
+    }
+    template <class T, class UnaryPredicate>
+    typename std::enable_if<std::is_arithmetic<T>::value, T*>::type
+    remove_if(T* first, T* last, UnaryPredicate unary_pred) {
+        compact_if<T, UnaryPredicate, false> keep(unary_pred);
+        return first + tinystl::simd_compact(first, static_cast<size_t>(last - first), first, keep);
+    }
+
+    // unique
+    template <class ForwardIter, class BinaryPredicate>
+    ForwardIter unique(ForwardIter first, ForwardIter last, BinaryPredicate binary_pred) {
+        if (first == last) return last;
+        ForwardIter result = first;
+        while (++first != last) { if (!binary_pred(*result, *first) && ++result != first) *result = tinystl::move(*first); }
+        return ++result;
+    }
+    template <class ForwardIter>
+    ForwardIter unique(ForwardIter first, ForwardIter last) {
+        if (first == last) return last;
+        ForwardIter result = first;
+        while (++first != last) { if (!(*result == *first) && ++result != first) *result = tinystl::move(*first); }
+        return ++result;
+    }
+    // equality is transitive on arithmetic values (nan equals nothing), so comparing neighbours
+    // gives the same result as comparing with the last kept element
+    template <class T>
+    typename std::enable_if<std::is_arithmetic<T>::value, T*>::type
+    unique(T* first, T* last) {
+        if (first == last) return last;
+        compact_unique<T> keep(*first);
+        return first + 1 + tinystl::simd_compact(first + 1, static_cast<size_t>(last - first - 1), first + 1, keep);
+    }
+
+    // partition
+    template <class ForwardIter, class UnaryPredicate>
+    ForwardIter partition(ForwardIter first, ForwardIter last, UnaryPredicate unary_pred) {
+        for (; first != last && unary_pred(*first); ++first) {}
+        if (first == last) return first;
+        for (ForwardIter next = first; ++next != last;) {
+            if (unary_pred(*next)) { tinystl::iter_swap(first, next); ++first; }
+        }
+        return first;
+    }
+    // index of the lowest set bit of a non zero mask
+    inline unsigned lowest_set_bit(uint64_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+        unsigned k = 0;
+        for (; !(mask & 1); mask >>= 1) ++k;
+        return k;
+#endif
+    }
+
+    // arithmetic elements: the predicate masks of a block from each end mark the elements on the wrong side,
+    // which are swapped pairwise in bit order. the blocks left over at the end are partitioned from their
+    // recorded classes, so the predicate is still applied once per element
+    template <class T, class UnaryPredicate>
+    typename std::enable_if<std::is_arithmetic<T>::value, T*>::type
+    partition(T* first, T* last, UnaryPredicate unary_pred) {
+        const size_t block = simd_compact_chunk;
+        compact_if<T, UnaryPredicate, true> classify(unary_pred);
+        T* base_l = first;
+        T* base_r = last;
+        uint64_t wrong_l = 0, wrong_r = 0;
+        for (;;) {
+            if (wrong_l == 0) {
+                if (static_cast<size_t>(last - first) < block) break;
+                base_l = first;
+                wrong_l = ~classify(first, block);
+                first += block;
+            }
+            if (wrong_r == 0) {
+                if (static_cast<size_t>(last - first) < block) break;
+                last -= block;
+                base_r = last;
+                wrong_r = classify(last, block);
+            }
+            for (; wrong_l != 0 && wrong_r != 0; wrong_l &= wrong_l - 1, wrong_r &= wrong_r - 1)
+                tinystl::swap(base_l[tinystl::lowest_set_bit(wrong_l)], base_r[tinystl::lowest_set_bit(wrong_r)]);
+        }
+        // the unclassified middle plus the pending block next to it, at most two blocks
+        unsigned char keep[2 * simd_compact_chunk];
+        const size_t tail = static_cast<size_t>(last - first);
+        const uint64_t mid = classify(first, tail);
+        T* lo = first;
+        size_t n = 0;
+        if (wrong_l != 0) { lo = base_l; for (size_t k = 0; k < block; ++k) keep[n++] = !(wrong_l >> k & 1); }
+        for (size_t k = 0; k < tail; ++k) keep[n++] = mid >> k & 1;
+        if (wrong_r != 0) { for (size_t k = 0; k < block; ++k) keep[n++] = wrong_r >> k & 1; }
+        size_t i = 0, j = n;
+        for (;;) {
+            while (i < j && keep[i]) ++i;
+            while (i < j && !keep[j - 1]) --j;
+            if (i >= j) break;
+            tinystl::swap(lo[i], lo[j - 1]);
+            ++i;
+            --j;
+        }
+        return lo + i;
+    }
 
     // copy n
     template <class InputIter, class Size, class OutputIter>
@@ -117,11 +285,13 @@ namespace tinystl {
     typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value, Up*>::type
     unchecked_move(Tp* first, Tp* last, Up* result) {
         const size_t n = static_cast<size_t>(last - first);
-        if ( n != 0 ) std::memmove(result, first, n * sizeof(Up));
+        tinystl::simd_copy(result, first, n * sizeof(Up));
         return result + n;
     }
     template <class InputIter, class OutputIter>
-    OutputIter move(InputIter first, InputIter last, OutputIter result) { return unchecked_move(first, last, result); }
+    OutputIter move(InputIter first, InputIter last, OutputIter result) {
+        return tinystl::rewrap_iter(result, unchecked_move(tinystl::unwrap_iter(first), tinystl::unwrap_iter(last), tinystl::unwrap_iter(result)));
+    }
 
     // move backward
     template <class BidirectionalIter1, class BidirectionalIter2>
@@ -140,40 +310,158 @@ namespace tinystl {
     typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value, Up*>::type
     unchecked_move_backward(Tp* first, Tp* last, Up* result) {
         const size_t n = static_cast<size_t>(last - first);
-        if (n != 0) { result -= n; std::memmove(result, first, n * sizeof(Up)); }
+        result -= n;
+        tinystl::simd_copy(result, first, n * sizeof(Up));
         return result;
     }
     template <class BidirectionalIter1, class BidirectionalIter2>
     BidirectionalIter2 move_backward(BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
-        return unchecked_move_backward(first, last, result);
+        return tinystl::rewrap_iter(result, unchecked_move_backward(tinystl::unwrap_iter(first), tinystl::unwrap_iter(last), tinystl::unwrap_iter(result)));
+    }
+
+    // reversed pointer ranges: between a reversed and a forward range the elements are a reverse copy of
+    // the underlying pointers, between two reversed ranges they are a copy the other way round
+    template <class Tp, class Up>
+    bool unchecked_reverse_copy(Tp* src, size_t n, Up* dst) {
+        // overlapping ranges are left to the element loops, which define the order of the writes
+        const uintptr_t s = reinterpret_cast<uintptr_t>(src);
+        const uintptr_t d = reinterpret_cast<uintptr_t>(dst);
+        const uintptr_t bytes = n * sizeof(Up);
+        if (s < d + bytes && d < s + bytes) return false;
+        tinystl::simd_reverse_copy(dst, src, n);
+        return true;
+    }
+
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value, Up*>::type
+    unchecked_copy(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, Up* result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(last.base(), n, result)) return unchecked_copy_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result + n;
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value, reverse_iterator<Up*>>::type
+    unchecked_copy(Tp* first, Tp* last, reverse_iterator<Up*> result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(first, n, result.base() - n)) return unchecked_copy_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result + n;
+    }
+    template <class Tp, class Up>
+    reverse_iterator<Up*> unchecked_copy(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_copy_backward(last.base(), first.base(), result.base()));
+    }
+
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value, Up*>::type
+    unchecked_copy_backward(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, Up* result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(last.base(), n, result - n)) return unchecked_copy_backward_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result - n;
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value, reverse_iterator<Up*>>::type
+    unchecked_copy_backward(Tp* first, Tp* last, reverse_iterator<Up*> result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(first, n, result.base())) return unchecked_copy_backward_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result - n;
+    }
+    template <class Tp, class Up>
+    reverse_iterator<Up*> unchecked_copy_backward(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_copy(last.base(), first.base(), result.base()));
+    }
+
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value, Up*>::type
+    unchecked_move(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, Up* result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(last.base(), n, result)) return unchecked_move_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result + n;
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value, reverse_iterator<Up*>>::type
+    unchecked_move(Tp* first, Tp* last, reverse_iterator<Up*> result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(first, n, result.base() - n)) return unchecked_move_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result + n;
+    }
+    template <class Tp, class Up>
+    reverse_iterator<Up*> unchecked_move(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_move_backward(last.base(), first.base(), result.base()));
+    }
+
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value, Up*>::type
+    unchecked_move_backward(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, Up* result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(last.base(), n, result - n)) return unchecked_move_backward_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result - n;
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value, reverse_iterator<Up*>>::type
+    unchecked_move_backward(Tp* first, Tp* last, reverse_iterator<Up*> result) {
+        const auto n = static_cast<size_t>(last - first);
+        if (!tinystl::unchecked_reverse_copy(first, n, result.base())) return unchecked_move_backward_cat(first, last, result, tinystl::random_access_iterator_tag());
+        return result - n;
+    }
+    template <class Tp, class Up>
+    reverse_iterator<Up*> unchecked_move_backward(reverse_iterator<Tp*> first, reverse_iterator<Tp*> last, reverse_iterator<Up*> result) {
+        return reverse_iterator<Up*>(unchecked_move(last.base(), first.base(), result.base()));
     }
 
     // equal
     template <class InputIter1, class InputIter2>
-    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    bool unchecked_equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
         for (; first1 != last1; ++first1, ++first2) { if (*first1 != *first2) return false;} return true;
     }
     template <class InputIter1, class InputIter2, class Compared>
     bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
         for (; first1 != last1; ++first1, ++first2) { if (!comp(*first1, *first2)) return false;} return true;
     }
+    template <class Tp, class Up>
+    typename std::enable_if<bitwise_comparable_ptr<Tp, Up>::value, bool>::type
+    unchecked_equal(Tp* first1, Tp* last1, Up* first2) {
+        const auto n = static_cast<size_t>(last1 - first1) * sizeof(Tp);
+        return tinystl::simd_mismatch(first1, first2, n) == n;
+    }
+    template <class InputIter1, class InputIter2>
+    bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+        return unchecked_equal(tinystl::unwrap_iter(first1), tinystl::unwrap_iter(last1), tinystl::unwrap_iter(first2));
+    }
 
     // fill n
     template <class OutputIter, class Size, class T>
     OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
         for (; n > 0; --n, ++first) { *first = value; } return first;
     }
+    // trivially copyable element types filled by replicating the bytes of one converted value
+    template <class Tp, class Up>
+    struct is_pattern_fillable : public bool_constant<std::is_trivially_copyable<Tp>::value && std::is_trivially_copy_assignable<Tp>::value && !std::is_volatile<Tp>::value &&
+        (std::is_same<typename std::remove_cv<Up>::type, Tp>::value || (std::is_arithmetic<Tp>::value && std::is_arithmetic<Up>::value))> {};
+
     template <class Tp, class Size, class Up>
-    typename std::enable_if<std::is_integral<Tp>::value && sizeof(Tp) == 1 && !std::is_same<Tp, bool>::value && std::is_integral<Up>::value && sizeof(Up) == 1, Tp*>::type
-    unchecked_fill_n(Tp* first, Size n, Up value) { if (n > 0) { std::memset(first, (unsigned char)value, (size_t)(n)); } return first + n; }
+    typename std::enable_if<is_pattern_fillable<Tp, Up>::value, Tp*>::type
+    unchecked_fill_n(Tp* first, Size n, const Up& value) {
+        if (n <= 0) return first;
+        const Tp tmp = static_cast<Tp>(value);
+        if (!tinystl::simd_fill(first, &tmp, sizeof(Tp), static_cast<size_t>(n))) {
+            for (Size i = 0; i < n; ++i) first[i] = tmp;
+        }
+        return first + n;
+    }
     template <class OutputIter, class Size, class T>
-    OutputIter fill_n(OutputIter first, Size n, const T& value) { return unchecked_fill_n(first, n, value); }
+    OutputIter fill_n(OutputIter first, Size n, const T& value) {
+        return tinystl::rewrap_iter(first, unchecked_fill_n(tinystl::unwrap_iter(first), n, value));
+    }
 
     // fill
     template <class ForwardIter, class T>
     void fill_cat(ForwardIter first, ForwardIter last, const T& value, tinystl::forward_iterator_tag) {
         for (; first != last; ++first) { *first = value; }
     }
+    template <class RandomIter, class T>
+    void fill_cat(RandomIter first, RandomIter last, const T& value, tinystl::random_access_iterator_tag) {
+        tinystl::fill_n(first, last - first, value);
+    }
     template <class ForwardIter, class T>
     void fill(ForwardIter first, ForwardIter last, const T& value) {
         fill_cat(first, last, value, iterator_category(first));
@@ -196,7 +484,16 @@ namespace tinystl {
         }
         return first1 == last1 && first2 != last2;
     }
-    bool lexicographical_compare(const unsigned char* first1, const unsigned char* last1, const unsigned char* first2, const unsigned char* last2) {
+    template <class Tp, class Up>
+    typename std::enable_if<bitwise_comparable_ptr<Tp, Up>::value, bool>::type
+    lexicographical_compare(Tp* first1, Tp* last1, Up* first2, Up* last2) {
+        const auto len1 = last1 - first1;
+        const auto len2 = last2 - first2;
+        const auto len = tinystl::min(len1, len2);
+        const auto i = static_cast<ptrdiff_t>(tinystl::simd_mismatch(first1, first2, static_cast<size_t>(len) * sizeof(Tp)) / sizeof(Tp));
+        return i < len ? first1[i] < first2[i] : len1 < len2;
+    }
+    inline bool lexicographical_compare(const unsigned char* first1, const unsigned char* last1, const unsigned char* first2, const unsigned char* last2) {
         const auto len1 = last1 - first1;
         const auto len2 = last2 - first2;
         const auto result = std::memcmp(first1, first2, tinystl::min(len1, len2));
@@ -209,6 +506,12 @@ namespace tinystl {
         while (first1 != last1 && *first1 == *first2) { ++first1; ++first2; }
         return tinystl::pair<InputIter1, InputIter2>(first1, first2);
     }
+    template <class Tp, class Up>
+    typename std::enable_if<bitwise_comparable_ptr<Tp, Up>::value, tinystl::pair<Tp*, Up*>>::type
+    mismatch(Tp* first1, Tp* last1, Up* first2) {
+        const auto i = tinystl::simd_mismatch(first1, first2, static_cast<size_t>(last1 - first1) * sizeof(Tp)) / sizeof(Tp);
+        return tinystl::pair<Tp*, Up*>(first1 + i, first2 + i);
+    }
 
 }
 
@@ -25,7 +25,7 @@ namespace tinystl {
         static void deallocate(T* ptr, size_type n);
 
         static void construct(T* ptr);
-        static void construct(T* ptr, size_type n);
+        static void construct(T* ptr, const T& value);
         static void construct(T* ptr, T&& value);
 
         template <class ...Args> static void construct(T* ptr, Args&& ...args);
@@ -48,7 +48,7 @@ namespace tinystl {
         ::operator delete(ptr);
     }
     template <class T>
-    void allocator<T>::deallocate(T *ptr, size_type size) {
+    void allocator<T>::deallocate(T *ptr, size_type) {
         if (ptr == nullptr) return;
         ::operator delete(ptr);
     }
@@ -56,7 +56,7 @@ namespace tinystl {
     template <class T> void allocator<T>::construct(T *ptr) { tinystl::construct(ptr); }
     template <class T> void allocator<T>::construct(T *ptr, const T& value) { tinystl::construct(ptr, value); }
     template <class T> void allocator<T>::construct(T *ptr, T&& value) { tinystl::construct(ptr, tinystl::move(value)); }
-    template <class T, class ...Args> void allocator<T>::construct(T *ptr, Args&& ...args) {
+    template <class T> template <class ...Args> void allocator<T>::construct(T *ptr, Args&& ...args) {
         tinystl::construct(ptr, tinystl::forward<Args>(args)...);
     }
 
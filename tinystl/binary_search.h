@@ -0,0 +1,133 @@
+#ifndef TINYSTL_BINARY_SEARCH_H_
+#define TINYSTL_BINARY_SEARCH_H_
+
+// binary search on sorted ranges: branchless with prefetching on random access iterators
+
+#include <cstddef>
+
+#include "functional.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // random access ranges at least this long prefetch both possible midpoints of the next step
+    const ptrdiff_t search_prefetch_threshold = 64;
+
+    template <class RandomIter>
+    inline void search_prefetch(RandomIter it) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&*it);
+#else
+        (void)it;
+#endif
+    }
+
+    // lower bound
+    template <class ForwardIter, class T, class Compared>
+    ForwardIter lower_bound_cat(ForwardIter first, ForwardIter last, const T& value, Compared comp, tinystl::forward_iterator_tag) {
+        auto len = tinystl::distance(first, last);
+        while (len > 0) {
+            const auto half = len / 2;
+            ForwardIter middle = first;
+            tinystl::advance(middle, half);
+            if (comp(*middle, value)) { first = ++middle; len -= half + 1; }
+            else len = half;
+        }
+        return first;
+    }
+
+    // the range halves without a data dependent branch, the compare only selects the next base
+    template <class RandomIter, class T, class Compared>
+    RandomIter lower_bound_cat(RandomIter first, RandomIter last, const T& value, Compared comp, tinystl::random_access_iterator_tag) {
+        auto len = last - first;
+        if (len == 0) return first;
+        while (len > 1) {
+            const auto half = len / 2;
+            if (len >= search_prefetch_threshold) {
+                tinystl::search_prefetch(first + half / 2);
+                tinystl::search_prefetch(first + (half + half / 2));
+            }
+            first = comp(*(first + half), value) ? first + half : first;
+            len -= half;
+        }
+        return comp(*first, value) ? first + 1 : first;
+    }
+
+    template <class ForwardIter, class T, class Compared>
+    ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
+        return tinystl::lower_bound_cat(first, last, value, comp, iterator_category(first));
+    }
+
+    template <class ForwardIter, class T>
+    ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value) {
+        return tinystl::lower_bound(first, last, value, tinystl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    // upper bound
+    template <class ForwardIter, class T, class Compared>
+    ForwardIter upper_bound_cat(ForwardIter first, ForwardIter last, const T& value, Compared comp, tinystl::forward_iterator_tag) {
+        auto len = tinystl::distance(first, last);
+        while (len > 0) {
+            const auto half = len / 2;
+            ForwardIter middle = first;
+            tinystl::advance(middle, half);
+            if (!comp(value, *middle)) { first = ++middle; len -= half + 1; }
+            else len = half;
+        }
+        return first;
+    }
+
+    template <class RandomIter, class T, class Compared>
+    RandomIter upper_bound_cat(RandomIter first, RandomIter last, const T& value, Compared comp, tinystl::random_access_iterator_tag) {
+        auto len = last - first;
+        if (len == 0) return first;
+        while (len > 1) {
+            const auto half = len / 2;
+            if (len >= search_prefetch_threshold) {
+                tinystl::search_prefetch(first + half / 2);
+                tinystl::search_prefetch(first + (half + half / 2));
+            }
+            first = comp(value, *(first + half)) ? first : first + half;
+            len -= half;
+        }
+        return comp(value, *first) ? first : first + 1;
+    }
+
+    template <class ForwardIter, class T, class Compared>
+    ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
+        return tinystl::upper_bound_cat(first, last, value, comp, iterator_category(first));
+    }
+
+    template <class ForwardIter, class T>
+    ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value) {
+        return tinystl::upper_bound(first, last, value, tinystl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    // binary search
+    template <class ForwardIter, class T, class Compared>
+    bool binary_search(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
+        first = tinystl::lower_bound(first, last, value, comp);
+        return first != last && !comp(value, *first);
+    }
+
+    template <class ForwardIter, class T>
+    bool binary_search(ForwardIter first, ForwardIter last, const T& value) {
+        return tinystl::binary_search(first, last, value, tinystl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    // equal range: the upper bound is searched only past the lower one
+    template <class ForwardIter, class T, class Compared>
+    tinystl::pair<ForwardIter, ForwardIter> equal_range(ForwardIter first, ForwardIter last, const T& value, Compared comp) {
+        first = tinystl::lower_bound(first, last, value, comp);
+        return tinystl::pair<ForwardIter, ForwardIter>(first, tinystl::upper_bound(first, last, value, comp));
+    }
+
+    template <class ForwardIter, class T>
+    tinystl::pair<ForwardIter, ForwardIter> equal_range(ForwardIter first, ForwardIter last, const T& value) {
+        return tinystl::equal_range(first, last, value, tinystl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+}
+
+#endif //TINYSTL_BINARY_SEARCH_H_
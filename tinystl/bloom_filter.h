@@ -0,0 +1,165 @@
+#ifndef TINYSTL_BLOOM_FILTER_H_
+#define TINYSTL_BLOOM_FILTER_H_
+
+// blocked bloom filter: all bits of a key live in one 64 byte block, so a lookup touches one cache line
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "allocator.h"
+#include "functional.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // class: bloom filter
+    // a block is 16 words of 32 bits, a key sets k bits of a single block
+    template <class Key, class Hash = tinystl::hash<Key>>
+    class bloom_filter {
+    public:
+        typedef Key         key_type;
+        typedef Hash        hasher;
+        typedef size_t      size_type;
+
+        static const size_type block_words = 16;
+        static const size_type block_bytes = block_words * sizeof(uint32_t);
+
+    private:
+        uint32_t* raw;
+        uint32_t* blocks;
+        size_type block_count;
+        unsigned k;
+        size_type count;
+        hasher hash;
+
+    public:
+        // sized for `expected` keys at the false positive rate `fpr`
+        bloom_filter(size_type expected, double fpr, const hasher& hf = hasher());
+        bloom_filter(bloom_filter&& rhs) noexcept : raw(rhs.raw), blocks(rhs.blocks), block_count(rhs.block_count), k(rhs.k), count(rhs.count), hash(rhs.hash) {
+            rhs.raw = rhs.blocks = nullptr;
+            rhs.block_count = rhs.count = 0;
+        }
+        bloom_filter& operator=(bloom_filter&& rhs) noexcept { bloom_filter tmp(tinystl::move(rhs)); swap(tmp); return *this; }
+        ~bloom_filter() { tinystl::allocator<uint32_t>::deallocate(raw); }
+
+    private:
+        bloom_filter(const bloom_filter&);
+        void operator=(const bloom_filter&);
+
+    public:
+        void insert(const key_type& key);
+        bool contains(const key_type& key) const;
+        void clear() noexcept { if (blocks) std::memset(blocks, 0, block_count * block_bytes); count = 0; }
+
+        size_type size() const noexcept { return count; }
+        size_type bit_count() const noexcept { return block_count * block_bytes * 8; }
+        unsigned hash_count() const noexcept { return k; }
+        hasher hash_function() const { return hash; }
+
+        void swap(bloom_filter& rhs) noexcept {
+            tinystl::swap(raw, rhs.raw);
+            tinystl::swap(blocks, rhs.blocks);
+            tinystl::swap(block_count, rhs.block_count);
+            tinystl::swap(k, rhs.k);
+            tinystl::swap(count, rhs.count);
+            tinystl::swap(hash, rhs.hash);
+        }
+
+    private:
+        uint64_t key_hash(const key_type& key) const { return tinystl::hash_mix(static_cast<uint64_t>(hash(key))); }
+        uint32_t* block_of(uint64_t h) const { return blocks + ((h >> 32) * block_count >> 32) * block_words; }
+        void make_mask(uint32_t h, uint32_t* mask) const;
+    };
+
+    template <class Key, class Hash>
+    const typename bloom_filter<Key, Hash>::size_type bloom_filter<Key, Hash>::block_words;
+    template <class Key, class Hash>
+    const typename bloom_filter<Key, Hash>::size_type bloom_filter<Key, Hash>::block_bytes;
+
+    template <class Key, class Hash>
+    bloom_filter<Key, Hash>::bloom_filter(size_type expected, double fpr, const hasher& hf)
+        : raw(nullptr), blocks(nullptr), block_count(0), k(0), count(0), hash(hf) {
+        if (expected == 0) expected = 1;
+        if (!(fpr > 0.0 && fpr < 1.0)) fpr = 0.01;
+        // optimal k and bits per key for a classic filter, plus some slack for the block imbalance
+        const double ln2 = 0.6931471805599453;
+        const double bits_per_key = -std::log(fpr) / (ln2 * ln2) * 1.2;
+        const double best_k = std::ceil(-std::log(fpr) / ln2);
+        k = best_k < 1.0 ? 1u : best_k > static_cast<double>(block_words) ? static_cast<unsigned>(block_words) : static_cast<unsigned>(best_k);
+        const double bits = bits_per_key * static_cast<double>(expected);
+        block_count = static_cast<size_type>(std::ceil(bits / (block_bytes * 8)));
+        if (block_count == 0) block_count = 1;
+        // over allocate one block to align the table to a cache line
+        raw = tinystl::allocator<uint32_t>::allocate((block_count + 1) * block_words);
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+        blocks = reinterpret_cast<uint32_t*>((addr + block_bytes - 1) & ~static_cast<uintptr_t>(block_bytes - 1));
+        std::memset(blocks, 0, block_count * block_bytes);
+    }
+
+    // bit i is chosen by multiplying the hash with an odd salt: top 4 bits pick the word, next 5 the bit
+    template <class Key, class Hash>
+    void bloom_filter<Key, Hash>::make_mask(uint32_t h, uint32_t* mask) const {
+        static const uint32_t salt[block_words] = {
+            0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u,
+            0x9e3779b1u, 0x85ebca77u, 0xc2b2ae3du, 0x27d4eb2fu, 0x165667b1u, 0xd3a2646du, 0xfd7046c5u, 0xb55a4f09u
+        };
+        for (size_type i = 0; i < block_words; ++i) mask[i] = 0;
+        for (unsigned i = 0; i < k; ++i) {
+            const uint32_t x = h * salt[i];
+            mask[x >> 28] |= 1u << ((x >> 23) & 31);
+        }
+    }
+
+    template <class Key, class Hash>
+    void bloom_filter<Key, Hash>::insert(const key_type& key) {
+        const uint64_t h = key_hash(key);
+        uint32_t* block = block_of(h);
+        uint32_t mask[block_words];
+        make_mask(static_cast<uint32_t>(h), mask);
+        for (size_type i = 0; i < block_words; ++i) block[i] |= mask[i];
+        ++count;
+    }
+
+    template <class Key, class Hash>
+    bool bloom_filter<Key, Hash>::contains(const key_type& key) const {
+        const uint64_t h = key_hash(key);
+        const uint32_t* block = block_of(h);
+        uint32_t mask[block_words];
+        make_mask(static_cast<uint32_t>(h), mask);
+#if defined(__AVX2__)
+        const __m256i b0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+        const __m256i b1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + 8));
+        const __m256i m0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask));
+        const __m256i m1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + 8));
+        // testc: every bit of the mask is set in the block
+        return _mm256_testc_si256(b0, m0) & _mm256_testc_si256(b1, m1);
+#elif defined(__SSE2__)
+        __m128i miss = _mm_setzero_si128();
+        for (size_type i = 0; i < block_words; i += 4) {
+            const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(block + i));
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i));
+            miss = _mm_or_si128(miss, _mm_andnot_si128(b, m));
+        }
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(miss, _mm_setzero_si128())) == 0xffff;
+#else
+        uint32_t miss = 0;
+        for (size_type i = 0; i < block_words; ++i) miss |= mask[i] & ~block[i];
+        return miss == 0;
+#endif
+    }
+
+    // overload swap
+    template <class Key, class Hash>
+    void swap(bloom_filter<Key, Hash>& lhs, bloom_filter<Key, Hash>& rhs) noexcept { lhs.swap(rhs); }
+
+}
+
+#endif //TINYSTL_BLOOM_FILTER_H_
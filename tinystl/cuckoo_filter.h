@@ -0,0 +1,217 @@
+#ifndef TINYSTL_CUCKOO_FILTER_H_
+#define TINYSTL_CUCKOO_FILTER_H_
+
+// cuckoo filter: approximate membership with deletion, fingerprints stored in buckets of four
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "allocator.h"
+#include "functional.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // class: cuckoo filter
+    // every key has two candidate buckets, the second derived from the first and the fingerprint (partial key cuckoo hashing)
+    template <class Key, class Hash = tinystl::hash<Key>>
+    class cuckoo_filter {
+    public:
+        typedef Key         key_type;
+        typedef Hash        hasher;
+        typedef size_t      size_type;
+
+        static const size_type bucket_slots = 4;
+        static const unsigned max_kicks = 500;
+
+    private:
+        uint16_t* table;
+        size_type bucket_mask;
+        unsigned fp_bits;
+        size_type count;
+        bool has_victim;
+        size_type victim_index;
+        uint16_t victim_fp;
+        uint64_t rng;
+        hasher hash;
+
+    public:
+        // room for `capacity` keys at the false positive rate `fpr`
+        cuckoo_filter(size_type capacity, double fpr, const hasher& hf = hasher());
+        cuckoo_filter(cuckoo_filter&& rhs) noexcept
+            : table(rhs.table), bucket_mask(rhs.bucket_mask), fp_bits(rhs.fp_bits), count(rhs.count),
+              has_victim(rhs.has_victim), victim_index(rhs.victim_index), victim_fp(rhs.victim_fp), rng(rhs.rng), hash(rhs.hash) {
+            rhs.table = nullptr;
+            rhs.bucket_mask = rhs.count = 0;
+            rhs.has_victim = false;
+        }
+        cuckoo_filter& operator=(cuckoo_filter&& rhs) noexcept { cuckoo_filter tmp(tinystl::move(rhs)); swap(tmp); return *this; }
+        ~cuckoo_filter() { tinystl::allocator<uint16_t>::deallocate(table); }
+
+    private:
+        cuckoo_filter(const cuckoo_filter&);
+        void operator=(const cuckoo_filter&);
+
+    public:
+        // false when the filter is full, the key is then not stored
+        bool insert(const key_type& key);
+        bool contains(const key_type& key) const;
+        // only erase keys that were inserted, otherwise another key sharing the fingerprint is removed
+        bool erase(const key_type& key);
+        void clear() noexcept;
+
+        size_type size() const noexcept { return count; }
+        size_type bucket_count() const noexcept { return table ? bucket_mask + 1 : 0; }
+        size_type capacity() const noexcept { return bucket_count() * bucket_slots; }
+        unsigned fingerprint_bits() const noexcept { return fp_bits; }
+        hasher hash_function() const { return hash; }
+
+        void swap(cuckoo_filter& rhs) noexcept {
+            tinystl::swap(table, rhs.table);
+            tinystl::swap(bucket_mask, rhs.bucket_mask);
+            tinystl::swap(fp_bits, rhs.fp_bits);
+            tinystl::swap(count, rhs.count);
+            tinystl::swap(has_victim, rhs.has_victim);
+            tinystl::swap(victim_index, rhs.victim_index);
+            tinystl::swap(victim_fp, rhs.victim_fp);
+            tinystl::swap(rng, rhs.rng);
+            tinystl::swap(hash, rhs.hash);
+        }
+
+    private:
+        void locate(const key_type& key, size_type& index, uint16_t& fp) const;
+        size_type alt_index(size_type index, uint16_t fp) const noexcept { return (index ^ static_cast<size_type>(tinystl::hash_mix(fp))) & bucket_mask; }
+        uint16_t* bucket(size_type index) const noexcept { return table + index * bucket_slots; }
+        bool bucket_has(size_type index, uint16_t fp) const noexcept;
+        bool bucket_insert(size_type index, uint16_t fp) noexcept;
+        bool bucket_erase(size_type index, uint16_t fp) noexcept;
+    };
+
+    template <class Key, class Hash>
+    const typename cuckoo_filter<Key, Hash>::size_type cuckoo_filter<Key, Hash>::bucket_slots;
+    template <class Key, class Hash>
+    const unsigned cuckoo_filter<Key, Hash>::max_kicks;
+
+    template <class Key, class Hash>
+    cuckoo_filter<Key, Hash>::cuckoo_filter(size_type capacity, double fpr, const hasher& hf)
+        : table(nullptr), bucket_mask(0), fp_bits(0), count(0), has_victim(false), victim_index(0), victim_fp(0),
+          rng(0x9e3779b97f4a7c15ull), hash(hf) {
+        if (capacity == 0) capacity = 1;
+        if (!(fpr > 0.0 && fpr < 1.0)) fpr = 0.01;
+        // a lookup compares against 2 * bucket_slots fingerprints: fpr ~= 8 / 2^f
+        const double bits = std::ceil(std::log2(2.0 * bucket_slots / fpr));
+        fp_bits = bits < 4.0 ? 4u : bits > 16.0 ? 16u : static_cast<unsigned>(bits);
+        // at most 95% load, bucket count a power of two
+        size_type buckets = 1;
+        while (buckets * bucket_slots * 95 < capacity * 100) buckets <<= 1;
+        bucket_mask = buckets - 1;
+        table = tinystl::allocator<uint16_t>::allocate(buckets * bucket_slots);
+        std::memset(table, 0, buckets * bucket_slots * sizeof(uint16_t));
+    }
+
+    template <class Key, class Hash>
+    void cuckoo_filter<Key, Hash>::locate(const key_type& key, size_type& index, uint16_t& fp) const {
+        const uint64_t h = tinystl::hash_mix(static_cast<uint64_t>(hash(key)));
+        index = static_cast<size_type>(h) & bucket_mask;
+        fp = static_cast<uint16_t>((h >> 32) & ((1u << fp_bits) - 1));
+        // zero marks an empty slot
+        if (fp == 0) fp = 1;
+    }
+
+    // compare all four slots at once: a zero 16 bit lane of (bucket ^ fp) means a match
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::bucket_has(size_type index, uint16_t fp) const noexcept {
+        uint64_t slots;
+        std::memcpy(&slots, bucket(index), sizeof(slots));
+        const uint64_t x = slots ^ (static_cast<uint64_t>(fp) * 0x0001000100010001ull);
+        return ((x - 0x0001000100010001ull) & ~x & 0x8000800080008000ull) != 0;
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::bucket_insert(size_type index, uint16_t fp) noexcept {
+        uint16_t* b = bucket(index);
+        for (size_type i = 0; i < bucket_slots; ++i) {
+            if (b[i] == 0) { b[i] = fp; return true; }
+        }
+        return false;
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::bucket_erase(size_type index, uint16_t fp) noexcept {
+        uint16_t* b = bucket(index);
+        for (size_type i = 0; i < bucket_slots; ++i) {
+            if (b[i] == fp) { b[i] = 0; return true; }
+        }
+        return false;
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::insert(const key_type& key) {
+        if (has_victim) return false;
+        size_type index;
+        uint16_t fp;
+        locate(key, index, fp);
+        if (bucket_insert(index, fp) || bucket_insert(alt_index(index, fp), fp)) { ++count; return true; }
+        // evict random residents until one finds a free slot in its other bucket
+        index = (rng & 1) ? alt_index(index, fp) : index;
+        for (unsigned kick = 0; kick < max_kicks; ++kick) {
+            rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+            uint16_t& slot = bucket(index)[rng % bucket_slots];
+            tinystl::swap(fp, slot);
+            index = alt_index(index, fp);
+            if (bucket_insert(index, fp)) { ++count; return true; }
+        }
+        // keep the homeless fingerprint so no inserted key is lost; further inserts fail
+        has_victim = true;
+        victim_index = index;
+        victim_fp = fp;
+        ++count;
+        return true;
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::contains(const key_type& key) const {
+        size_type index;
+        uint16_t fp;
+        locate(key, index, fp);
+        const size_type alt = alt_index(index, fp);
+        const bool found = bucket_has(index, fp) | bucket_has(alt, fp);
+        return found || (has_victim && victim_fp == fp && (victim_index == index || victim_index == alt));
+    }
+
+    template <class Key, class Hash>
+    bool cuckoo_filter<Key, Hash>::erase(const key_type& key) {
+        size_type index;
+        uint16_t fp;
+        locate(key, index, fp);
+        const size_type alt = alt_index(index, fp);
+        if (has_victim && victim_fp == fp && (victim_index == index || victim_index == alt)) {
+            has_victim = false;
+            --count;
+            return true;
+        }
+        if (!bucket_erase(index, fp) && !bucket_erase(alt, fp)) return false;
+        --count;
+        // a slot is free again, give the victim another chance
+        if (has_victim && (bucket_insert(victim_index, victim_fp) || bucket_insert(alt_index(victim_index, victim_fp), victim_fp))) {
+            has_victim = false;
+        }
+        return true;
+    }
+
+    template <class Key, class Hash>
+    void cuckoo_filter<Key, Hash>::clear() noexcept {
+        if (table) std::memset(table, 0, (bucket_mask + 1) * bucket_slots * sizeof(uint16_t));
+        count = 0;
+        has_victim = false;
+    }
+
+    // overload swap
+    template <class Key, class Hash>
+    void swap(cuckoo_filter<Key, Hash>& lhs, cuckoo_filter<Key, Hash>& rhs) noexcept { lhs.swap(rhs); }
+
+}
+
+#endif //TINYSTL_CUCKOO_FILTER_H_
@@ -0,0 +1,318 @@
+#ifndef TINYSTL_EXECUTION_H_
+#define TINYSTL_EXECUTION_H_
+
+// execution policies, and overloads of the algobase and uninitialized algorithms taking one
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "algobase.h"
+#include "iterator.h"
+#include "simd.h"
+#include "thread_pool.h"
+#include "type_traits.h"
+#include "uninitialized.h"
+
+namespace tinystl {
+
+    namespace execution {
+        struct sequenced_policy {};
+        struct parallel_policy {};
+        struct parallel_unsequenced_policy {};
+
+        const sequenced_policy seq{};
+        const parallel_policy par{};
+        const parallel_unsequenced_policy par_unseq{};
+    }
+
+    template <class T> struct is_execution_policy : tinystl::false_type {};
+    template <> struct is_execution_policy<execution::sequenced_policy> : tinystl::true_type {};
+    template <> struct is_execution_policy<execution::parallel_policy> : tinystl::true_type {};
+    template <> struct is_execution_policy<execution::parallel_unsequenced_policy> : tinystl::true_type {};
+
+    template <class ExecutionPolicy, class R>
+    struct enable_if_execution_policy : std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, R> {};
+
+    // ranges below this many bytes stay on the calling thread;
+    // define TINYSTL_PARALLEL_THRESHOLD (bytes) to override
+    inline size_t parallel_threshold() noexcept {
+#ifdef TINYSTL_PARALLEL_THRESHOLD
+        return static_cast<size_t>(TINYSTL_PARALLEL_THRESHOLD);
+#else
+        return static_cast<size_t>(1) << 20;
+#endif
+    }
+
+    // work is handed out in blocks of this many bytes; blocks written through a pointer start on these
+    // boundaries of the destination, see parallel_dest_blocks
+    const size_t parallel_block_bytes = 64 * 1024;
+
+    // parallel policies on random access iterators can split the range
+    template <class ExecutionPolicy, class... Iters>
+    struct is_parallel_execution;
+
+    template <class ExecutionPolicy>
+    struct is_parallel_execution<ExecutionPolicy> : bool_constant<
+        !std::is_same<typename std::decay<ExecutionPolicy>::type, execution::sequenced_policy>::value> {};
+
+    template <class ExecutionPolicy, class Iter, class... Iters>
+    struct is_parallel_execution<ExecutionPolicy, Iter, Iters...> : bool_constant<
+        std::is_convertible<typename iterator_traits<Iter>::iterator_category, random_access_iterator_tag>::value &&
+        is_parallel_execution<ExecutionPolicy, Iters...>::value> {};
+
+    // elements per block of a parallel range, 0 when the range is too small or there is a single thread
+    inline size_t parallel_block_size(size_t n, size_t elem_size) {
+        if (tinystl::default_thread_pool().size() < 2 || n * elem_size < parallel_threshold()) return 0;
+        const size_t block = parallel_block_bytes / elem_size;
+        return block == 0 ? 1 : block;
+    }
+
+    // hands the blocks of [0, n) out across the default pool, f(lo, hi) sees a run of whole blocks
+    template <class F>
+    void parallel_for_blocks(size_t n, size_t block, F f) {
+        const size_t blocks = (n + block - 1) / block;
+        tinystl::default_thread_pool().parallel_for(static_cast<size_t>(0), blocks, [&](size_t b, size_t e) {
+            f(b * block, e * block < n ? e * block : n);
+        }, 1);
+    }
+
+    // split [0, n) into blocks of elements of the given size across the default pool,
+    // false when the range is too small or there is a single thread
+    template <class F>
+    bool parallel_blocks(size_t n, size_t elem_size, F f) {
+        const size_t block = tinystl::parallel_block_size(n, elem_size);
+        if (block == 0) return false;
+        tinystl::parallel_for_blocks(n, block, f);
+        return true;
+    }
+
+    // the blocks of a range written to dst: each one opens at the first element on or after a
+    // parallel_block_bytes boundary of dst, so first touch places every page of a fresh buffer with the one
+    // thread that writes it. only a page an element straddles, when the element size does not divide the
+    // page, is shared by two threads
+    template <class T, class F>
+    bool parallel_dest_blocks(size_t n, T* dst, F f) {
+        if (tinystl::parallel_block_size(n, sizeof(T)) == 0) return false;
+        const size_t bytes = n * sizeof(T);
+        const size_t head = (parallel_block_bytes - reinterpret_cast<uintptr_t>(dst) % parallel_block_bytes) % parallel_block_bytes;
+        const size_t blocks = 1 + (bytes > head ? (bytes - head + parallel_block_bytes - 1) / parallel_block_bytes : 0);
+        // block k > 0 opens at byte head + (k - 1) * parallel_block_bytes, rounded up to an element
+        const auto start = [&](size_t k) -> size_t {
+            if (k == 0) return 0;
+            const size_t i = (head + (k - 1) * parallel_block_bytes + sizeof(T) - 1) / sizeof(T);
+            return i < n ? i : n;
+        };
+        tinystl::default_thread_pool().parallel_for(static_cast<size_t>(0), blocks, [&](size_t b, size_t e) {
+            const size_t lo = start(b), hi = start(e);
+            if (lo < hi) f(lo, hi);
+        }, 1);
+        return true;
+    }
+
+    // an iterator gives no address to align to, it takes the plain split
+    template <class Iter, class F>
+    bool parallel_dest_blocks(size_t n, Iter, F f) {
+        return tinystl::parallel_blocks(n, sizeof(typename iterator_traits<Iter>::value_type), f);
+    }
+
+    // one block of a parallel copy: the pointer fast path streams based on the size of the whole copy
+    template <class InputIter, class OutputIter>
+    void parallel_copy_block(InputIter first, InputIter last, OutputIter result, size_t) {
+        tinystl::copy(first, last, result);
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_copy_assignable<Up>::value>::type
+    parallel_copy_block(Tp* first, Tp* last, Up* result, size_t total) {
+        tinystl::simd_copy(result, first, static_cast<size_t>(last - first) * sizeof(Up), total);
+    }
+
+    template <class InputIter, class OutputIter>
+    void parallel_move_block(InputIter first, InputIter last, OutputIter result, size_t) {
+        tinystl::move(first, last, result);
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value && std::is_trivially_move_assignable<Up>::value>::type
+    parallel_move_block(Tp* first, Tp* last, Up* result, size_t total) {
+        tinystl::simd_copy(result, first, static_cast<size_t>(last - first) * sizeof(Up), total);
+    }
+
+    template <class OutputIter, class T>
+    void parallel_fill_block(OutputIter first, size_t n, const T& value, size_t) {
+        tinystl::fill_n(first, n, value);
+    }
+    template <class Tp, class Up>
+    typename std::enable_if<is_pattern_fillable<Tp, Up>::value>::type
+    parallel_fill_block(Tp* first, size_t n, const Up& value, size_t total) {
+        const Tp tmp = static_cast<Tp>(value);
+        if (!tinystl::simd_fill(first, &tmp, sizeof(Tp), n, total)) {
+            for (size_t i = 0; i < n; ++i) first[i] = tmp;
+        }
+    }
+
+    // copy
+    template <class ExecutionPolicy, class InputIter, class OutputIter>
+    OutputIter copy_policy(InputIter first, InputIter last, OutputIter result, tinystl::false_type) {
+        return tinystl::copy(first, last, result);
+    }
+    template <class ExecutionPolicy, class RandomIter1, class RandomIter2>
+    RandomIter2 copy_policy(RandomIter1 first, RandomIter1 last, RandomIter2 result, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter2>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t total = n * sizeof(value_type);
+        const auto src = tinystl::unwrap_iter(first);
+        const auto dst = tinystl::unwrap_iter(result);
+        if (!tinystl::parallel_dest_blocks(n, dst, [&](size_t b, size_t e) { tinystl::parallel_copy_block(src + b, src + e, dst + b, total); })) {
+            return tinystl::copy(first, last, result);
+        }
+        return result + n;
+    }
+    template <class ExecutionPolicy, class InputIter, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    copy(ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result) {
+        return tinystl::copy_policy<ExecutionPolicy>(first, last, result, is_parallel_execution<ExecutionPolicy, InputIter, OutputIter>());
+    }
+
+    // move
+    template <class ExecutionPolicy, class InputIter, class OutputIter>
+    OutputIter move_policy(InputIter first, InputIter last, OutputIter result, tinystl::false_type) {
+        return tinystl::move(first, last, result);
+    }
+    template <class ExecutionPolicy, class RandomIter1, class RandomIter2>
+    RandomIter2 move_policy(RandomIter1 first, RandomIter1 last, RandomIter2 result, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter2>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t total = n * sizeof(value_type);
+        const auto src = tinystl::unwrap_iter(first);
+        const auto dst = tinystl::unwrap_iter(result);
+        if (!tinystl::parallel_dest_blocks(n, dst, [&](size_t b, size_t e) { tinystl::parallel_move_block(src + b, src + e, dst + b, total); })) {
+            return tinystl::move(first, last, result);
+        }
+        return result + n;
+    }
+    template <class ExecutionPolicy, class InputIter, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    move(ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result) {
+        return tinystl::move_policy<ExecutionPolicy>(first, last, result, is_parallel_execution<ExecutionPolicy, InputIter, OutputIter>());
+    }
+
+    // fill n
+    template <class ExecutionPolicy, class OutputIter, class Size, class T>
+    OutputIter fill_n_policy(OutputIter first, Size n, const T& value, tinystl::false_type) {
+        return tinystl::fill_n(first, n, value);
+    }
+    template <class ExecutionPolicy, class RandomIter, class Size, class T>
+    RandomIter fill_n_policy(RandomIter first, Size n, const T& value, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (n <= 0) return first;
+        const size_t count = static_cast<size_t>(n);
+        const size_t total = count * sizeof(value_type);
+        const auto dst = tinystl::unwrap_iter(first);
+        if (!tinystl::parallel_dest_blocks(count, dst, [&](size_t b, size_t e) { tinystl::parallel_fill_block(dst + b, e - b, value, total); })) {
+            return tinystl::fill_n(first, n, value);
+        }
+        return first + n;
+    }
+    template <class ExecutionPolicy, class OutputIter, class Size, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    fill_n(ExecutionPolicy&&, OutputIter first, Size n, const T& value) {
+        return tinystl::fill_n_policy<ExecutionPolicy>(first, n, value, is_parallel_execution<ExecutionPolicy, OutputIter>());
+    }
+
+    // fill
+    template <class ExecutionPolicy, class ForwardIter, class T>
+    void fill_policy(ForwardIter first, ForwardIter last, const T& value, tinystl::false_type) {
+        tinystl::fill(first, last, value);
+    }
+    template <class ExecutionPolicy, class RandomIter, class T>
+    void fill_policy(RandomIter first, RandomIter last, const T& value, tinystl::true_type) {
+        tinystl::fill_n_policy<ExecutionPolicy>(first, last - first, value, tinystl::true_type());
+    }
+    template <class ExecutionPolicy, class ForwardIter, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, void>::type
+    fill(ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& value) {
+        tinystl::fill_policy<ExecutionPolicy>(first, last, value, is_parallel_execution<ExecutionPolicy, ForwardIter>());
+    }
+
+    // equal: blocks give up once another block has found a difference
+    template <class ExecutionPolicy, class InputIter1, class InputIter2>
+    bool equal_policy(InputIter1 first1, InputIter1 last1, InputIter2 first2, tinystl::false_type) {
+        return tinystl::equal(first1, last1, first2);
+    }
+    template <class ExecutionPolicy, class RandomIter1, class RandomIter2>
+    bool equal_policy(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        std::atomic<bool> differ(false);
+        const size_t n = static_cast<size_t>(last1 - first1);
+        if (!tinystl::parallel_blocks(n, sizeof(value_type), [&](size_t b, size_t e) {
+                if (differ.load(std::memory_order_relaxed)) return;
+                if (!tinystl::equal(first1 + b, first1 + e, first2 + b)) differ.store(true, std::memory_order_relaxed);
+            })) {
+            return tinystl::equal(first1, last1, first2);
+        }
+        return !differ.load(std::memory_order_relaxed);
+    }
+    template <class ExecutionPolicy, class InputIter1, class InputIter2>
+    typename enable_if_execution_policy<ExecutionPolicy, bool>::type
+    equal(ExecutionPolicy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+        return tinystl::equal_policy<ExecutionPolicy>(first1, last1, first2, is_parallel_execution<ExecutionPolicy, InputIter1, InputIter2>());
+    }
+
+    // uninitialized copy: only element types whose construction cannot throw are split,
+    // so no block ever has to unwind the others
+    template <class ExecutionPolicy, class InputIter, class ForwardIter>
+    ForwardIter uninit_copy_policy(InputIter first, InputIter last, ForwardIter result, tinystl::false_type) {
+        return tinystl::uninitialized_copy(first, last, result);
+    }
+    template <class ExecutionPolicy, class RandomIter1, class RandomIter2>
+    RandomIter2 uninit_copy_policy(RandomIter1 first, RandomIter1 last, RandomIter2 result, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter2>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t total = n * sizeof(value_type);
+        const auto src = tinystl::unwrap_iter(first);
+        const auto dst = tinystl::unwrap_iter(result);
+        const bool done = std::is_trivially_copy_assignable<value_type>::value
+            ? tinystl::parallel_dest_blocks(n, dst, [&](size_t b, size_t e) { tinystl::parallel_copy_block(src + b, src + e, dst + b, total); })
+            : tinystl::parallel_dest_blocks(n, dst, [&](size_t b, size_t e) { tinystl::uninitialized_copy(first + b, first + e, result + b); });
+        if (!done) return tinystl::uninitialized_copy(first, last, result);
+        return result + n;
+    }
+    template <class ExecutionPolicy, class InputIter, class ForwardIter>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+    uninitialized_copy(ExecutionPolicy&&, InputIter first, InputIter last, ForwardIter result) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        typedef typename iterator_traits<InputIter>::reference reference;
+        return tinystl::uninit_copy_policy<ExecutionPolicy>(first, last, result, bool_constant<
+            is_parallel_execution<ExecutionPolicy, InputIter, ForwardIter>::value && std::is_nothrow_constructible<value_type, reference>::value>());
+    }
+
+    // uninitialized fill n: every block is constructed by the thread that first touches its pages,
+    // which spreads a large buffer over the memory nodes of the threads that will work on it
+    template <class ExecutionPolicy, class ForwardIter, class Size, class T>
+    ForwardIter uninit_fill_n_policy(ForwardIter first, Size n, const T& value, tinystl::false_type) {
+        return tinystl::uninitialized_fill_n(first, n, value);
+    }
+    template <class ExecutionPolicy, class RandomIter, class Size, class T>
+    RandomIter uninit_fill_n_policy(RandomIter first, Size n, const T& value, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (n <= 0) return first;
+        const size_t count = static_cast<size_t>(n);
+        const size_t total = count * sizeof(value_type);
+        const auto dst = tinystl::unwrap_iter(first);
+        const bool done = std::is_trivially_copy_assignable<value_type>::value
+            ? tinystl::parallel_dest_blocks(count, dst, [&](size_t b, size_t e) { tinystl::parallel_fill_block(dst + b, e - b, value, total); })
+            : tinystl::parallel_dest_blocks(count, dst, [&](size_t b, size_t e) { tinystl::uninitialized_fill_n(first + b, e - b, value); });
+        if (!done) return tinystl::uninitialized_fill_n(first, n, value);
+        return first + n;
+    }
+    template <class ExecutionPolicy, class ForwardIter, class Size, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+    uninitialized_fill_n(ExecutionPolicy&&, ForwardIter first, Size n, const T& value) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        return tinystl::uninit_fill_n_policy<ExecutionPolicy>(first, n, value, bool_constant<
+            is_parallel_execution<ExecutionPolicy, ForwardIter>::value && std::is_nothrow_constructible<value_type, const T&>::value>());
+    }
+
+}
+
+#endif //TINYSTL_EXECUTION_H_
@@ -0,0 +1,195 @@
+#ifndef TINYSTL_EYTZINGER_INDEX_H_
+#define TINYSTL_EYTZINGER_INDEX_H_
+
+// static sorted index in eytzinger (bfs) order: the first levels of every search share a few cache lines
+// and the next levels are prefetched while the current compare resolves
+
+#include <cstddef>
+#include <cstdint>
+
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "sort.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // class: eytzinger index
+    // slot 1 is the root and the children of slot k are 2k and 2k + 1; a search walks down branchlessly
+    // and the answer is recovered from the path bits, slots are the handles returned by lookups
+    template <class Key, class Compared = tinystl::less<Key>>
+    class eytzinger_index {
+    public:
+        typedef Key         key_type;
+        typedef Compared    key_compare;
+        typedef size_t      size_type;
+
+        static const size_type npos = static_cast<size_type>(-1);
+        static const size_type line_bytes = 64;
+
+    private:
+        Key* raw;
+        Key* keys;
+        size_type n;
+        Compared comp;
+
+    public:
+        template <class ForwardIter>
+        eytzinger_index(ForwardIter first, ForwardIter last, const Compared& c = Compared());
+        eytzinger_index(eytzinger_index&& rhs) noexcept : raw(rhs.raw), keys(rhs.keys), n(rhs.n), comp(rhs.comp) {
+            rhs.raw = rhs.keys = nullptr;
+            rhs.n = 0;
+        }
+        eytzinger_index& operator=(eytzinger_index&& rhs) noexcept { eytzinger_index tmp(tinystl::move(rhs)); swap(tmp); return *this; }
+        ~eytzinger_index() {
+            if (keys) tinystl::allocator<Key>::destroy(keys + 1, keys + n + 1);
+            tinystl::allocator<Key>::deallocate(raw);
+        }
+
+    private:
+        eytzinger_index(const eytzinger_index&);
+        void operator=(const eytzinger_index&);
+
+    public:
+        // slot of the first key not less than key, npos if there is none
+        size_type lower_bound(const key_type& key) const {
+            size_type k = 1;
+            while (k <= n) {
+                prefetch(k);
+                k = 2 * k + static_cast<size_type>(comp(keys[k], key));
+            }
+            return to_slot(unwind(k));
+        }
+        // slot of the first key greater than key, npos if there is none
+        size_type upper_bound(const key_type& key) const {
+            size_type k = 1;
+            while (k <= n) {
+                prefetch(k);
+                k = 2 * k + static_cast<size_type>(!comp(key, keys[k]));
+            }
+            return to_slot(unwind(k));
+        }
+        size_type find(const key_type& key) const {
+            const size_type k = lower_bound(key);
+            return k != npos && !comp(key, keys[k]) ? k : npos;
+        }
+        bool contains(const key_type& key) const { return find(key) != npos; }
+
+        // in order walk: the slot of the smallest key and the successor of a slot, npos past the largest
+        size_type first() const noexcept { return n == 0 ? npos : leftmost(1); }
+        size_type next(size_type k) const noexcept { return 2 * k + 1 <= n ? leftmost(2 * k + 1) : to_slot(unwind(k)); }
+
+        const key_type& operator[](size_type k) const { return keys[k]; }
+
+        size_type size() const noexcept { return n; }
+        bool empty() const noexcept { return n == 0; }
+        key_compare key_comp() const { return comp; }
+
+        void swap(eytzinger_index& rhs) noexcept {
+            tinystl::swap(raw, rhs.raw);
+            tinystl::swap(keys, rhs.keys);
+            tinystl::swap(n, rhs.n);
+            tinystl::swap(comp, rhs.comp);
+        }
+
+    private:
+        // descendants of slot k a few levels down are contiguous, one line holds a whole level of them
+        static constexpr size_type prefetch_stride(size_type s = 1) {
+            return s * 2 * sizeof(Key) > line_bytes ? s : prefetch_stride(s * 2);
+        }
+        void prefetch(size_type k) const {
+#if defined(__GNUC__) || defined(__clang__)
+            // may point past the table, prefetches never fault
+            __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(keys) + k * prefetch_stride() * sizeof(Key)));
+#else
+            (void)k;
+#endif
+        }
+        // drops the trailing right turns and the final left turn of the path, leaving the last slot
+        // where the walk went left; zero if it never did
+        static size_type unwind(size_type k) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+            while (k & 1) k >>= 1;
+            return k >> 1;
+#endif
+        }
+        static size_type to_slot(size_type k) noexcept { return k == 0 ? npos : k; }
+        size_type leftmost(size_type k) const noexcept { while (2 * k <= n) k *= 2; return k; }
+
+        // the sorted copy the constructor lays out, destroyed and freed however the constructor leaves
+        struct sorted_copy {
+            Key* keys;
+            size_type n;
+            explicit sorted_copy(size_type len) : keys(tinystl::allocator<Key>::allocate(len)), n(0) {}
+            ~sorted_copy() {
+                tinystl::allocator<Key>::destroy(keys, keys + n);
+                tinystl::allocator<Key>::deallocate(keys);
+            }
+        };
+
+        void layout(Key* sorted, size_type& i, size_type k);
+        void unlayout(size_type& i, size_type k);
+    };
+
+    template <class Key, class Compared>
+    const typename eytzinger_index<Key, Compared>::size_type eytzinger_index<Key, Compared>::npos;
+    template <class Key, class Compared>
+    const typename eytzinger_index<Key, Compared>::size_type eytzinger_index<Key, Compared>::line_bytes;
+
+    template <class Key, class Compared>
+    template <class ForwardIter>
+    eytzinger_index<Key, Compared>::eytzinger_index(ForwardIter first, ForwardIter last, const Compared& c)
+        : raw(nullptr), keys(nullptr), n(0), comp(c) {
+        n = static_cast<size_type>(tinystl::distance(first, last));
+        if (n == 0) return;
+        // sort a copy, then move it into bfs order by an in order walk of the implicit tree
+        sorted_copy sorted(n);
+        tinystl::uninitialized_copy(first, last, sorted.keys);
+        sorted.n = n;
+        tinystl::sort(sorted.keys, sorted.keys + n, comp);
+        // slot 0 is never used; over allocate one line so slot 0 starts one when the key size allows
+        const size_type pad = line_bytes % sizeof(Key) == 0 ? line_bytes / sizeof(Key) : 0;
+        raw = tinystl::allocator<Key>::allocate(n + 1 + pad);
+        keys = raw;
+        if (pad != 0) {
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = (addr + line_bytes - 1) & ~static_cast<uintptr_t>(line_bytes - 1);
+            if ((aligned - addr) % sizeof(Key) == 0) keys = raw + (aligned - addr) / sizeof(Key);
+        }
+        size_type i = 0;
+        try {
+            layout(sorted.keys, i, 1);
+        } catch (...) {
+            unlayout(i, 1);
+            tinystl::allocator<Key>::deallocate(raw);
+            throw;
+        }
+    }
+
+    template <class Key, class Compared>
+    void eytzinger_index<Key, Compared>::layout(Key* sorted, size_type& i, size_type k) {
+        if (k > n) return;
+        layout(sorted, i, 2 * k);
+        tinystl::allocator<Key>::construct(keys + k, tinystl::move(sorted[i]));
+        ++i;
+        layout(sorted, i, 2 * k + 1);
+    }
+
+    // destroys the first i slots the in order walk of layout constructed
+    template <class Key, class Compared>
+    void eytzinger_index<Key, Compared>::unlayout(size_type& i, size_type k) {
+        if (k > n || i == 0) return;
+        unlayout(i, 2 * k);
+        if (i == 0) return;
+        tinystl::allocator<Key>::destroy(keys + k);
+        --i;
+        unlayout(i, 2 * k + 1);
+    }
+
+}
+
+#endif //TINYSTL_EYTZINGER_INDEX_H_
@@ -2,6 +2,8 @@
 #define TINYSTL_FUNCTIONAL_H_
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 
 namespace tinystl{
     // unary function
@@ -45,8 +47,23 @@ namespace tinystl{
         T operator()(const T& x) const { return -x; }
     };
 
+    template <class T>
+    struct minimum : public binary_function<T, T, T> {
+        T operator()(const T& x, const T& y) const { return y < x ? y : x; }
+    };
+    template <class T>
+    struct maximum : public binary_function<T, T, T> {
+        T operator()(const T& x, const T& y) const { return x < y ? y : x; }
+    };
+
     template <class T> T identity_element(plus<T>) { return T(0); }
     template <class T> T identity_element(multiplies<T>) { return T(1); }
+    template <class T> T identity_element(minimum<T>) {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+    template <class T> T identity_element(maximum<T>) {
+        return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    }
 
     template <class T>
     struct equal_to : public binary_function<T, T, bool> {
@@ -149,8 +166,19 @@ namespace tinystl{
 
     #undef TINYSTL_TRIVIAL_HASH_FCN
 
+    // remix a hash value so every output bit depends on every input bit (murmur3 finalizer),
+    // the trivial hashes above are the identity and make poor bucket or bit indices on their own
+    inline uint64_t hash_mix(uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
     inline size_t bitwise_hash(const unsigned char* first, size_t count) {
-    #if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) && __SIZEOF_POINTER__ == 8))
+    #if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) && __SIZEOF_POINTER__ == 8)
         const size_t fnv_offset = 14695981039346656037ull;
         const size_t fnv_prime = 1099511628211ull;
     #else
@@ -166,11 +194,11 @@ namespace tinystl{
     }
 
     template <>
-    struct hash<float> { size_t operator()(const float& val) { return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val,sizeof(float));}};
+    struct hash<float> { size_t operator()(const float& val) const { return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val,sizeof(float));}};
     template <>
-    struct hash<double> { size_t operator()(const double& val) { return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val, sizeof(double));}};
+    struct hash<double> { size_t operator()(const double& val) const { return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val, sizeof(double));}};
     template <>
-    struct hash<long double> { size_t operator()(const long double& val) { return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val,sizeof(long double));}};
+    struct hash<long double> { size_t operator()(const long double& val) const { return val == 0.0f ? 0 : bitwise_hash((const unsigned char *)&val,sizeof(long double));}};
 }
 
 #endif
@@ -19,7 +19,7 @@ namespace tinystl {
 
     template <class RandomIter, class Distance>
     void push_heap_d(RandomIter first, RandomIter last, Distance*) {
-        tinystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1));
+        tinystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), typename iterator_traits<RandomIter>::value_type(*(last - 1)));
     }
 
     template <class RandomIter>
@@ -40,7 +40,7 @@ namespace tinystl {
 
     template <class RandomIter, class Compared, class Distance>
     void push_heap_d(RandomIter first, RandomIter last, Distance*, Compared comp) {
-        tinystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), *(last - 1), comp);
+        tinystl::push_heap_aux(first, (last - first) - 1, static_cast<Distance>(0), typename iterator_traits<RandomIter>::value_type(*(last - 1)), comp);
     }
 
     template <class RandomIter, class Compared>
@@ -74,7 +74,7 @@ namespace tinystl {
 
     template <class RandomIter>
     void pop_heap(RandomIter first, RandomIter last) {
-        tinystl::pop_heap_aux(first, last - 1, last - 1, *(last -1), distance_type(first));
+        tinystl::pop_heap_aux(first, last - 1, last - 1, typename iterator_traits<RandomIter>::value_type(*(last - 1)), distance_type(first));
     }
 
     template <class RandomIter, class T, class Distance, class Compared>
@@ -82,7 +82,7 @@ namespace tinystl {
         auto topIndex = holeIndex;
         auto rchild = 2 * holeIndex + 2;
         while (rchild < len) {
-            if (comp(*(first + rchild) < *(first + rchild - 1))) --rchild;
+            if (comp(*(first + rchild), *(first + rchild - 1))) --rchild;
             *(first + holeIndex) = *(first + rchild);
             holeIndex = rchild;
             rchild = 2 * (rchild + 1);
@@ -102,7 +102,7 @@ namespace tinystl {
 
     template <class RandomIter, class Compared>
     void pop_heap(RandomIter first, RandomIter last, Compared comp) {
-        tinystl::pop_heap_aux(first, last - 1, last - 1, *(last -1), distance_type(first), comp);
+        tinystl::pop_heap_aux(first, last - 1, last - 1, typename iterator_traits<RandomIter>::value_type(*(last - 1)), distance_type(first), comp);
     }
 
     // sort heap
@@ -123,7 +123,7 @@ namespace tinystl {
         auto len = last - first;
         auto holeIndex = (len - 2) / 2;
         while (true) {
-            tinystl::adjust_heap(first, holeIndex, len, *(first + holeIndex));
+            tinystl::adjust_heap(first, holeIndex, len, typename iterator_traits<RandomIter>::value_type(*(first + holeIndex)));
             if (holeIndex == 0) return;
             holeIndex--;
         }
@@ -140,7 +140,7 @@ namespace tinystl {
         auto len = last - first;
         auto holeIndex = (len - 2) / 2;
         while (true) {
-            tinystl::adjust_heap(first, holeIndex, len, *(first + holeIndex), comp);
+            tinystl::adjust_heap(first, holeIndex, len, typename iterator_traits<RandomIter>::value_type(*(first + holeIndex)), comp);
             if (holeIndex == 0) return;
             holeIndex--;
         }
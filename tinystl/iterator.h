@@ -2,6 +2,7 @@
 #define TINYSTL_ITERATOR_H_
 
 #include <cstddef>
+#include <utility>
 
 #include "type_traits.h"
 
@@ -12,6 +13,8 @@ namespace tinystl {
     struct forward_iterator_tag : public input_iterator_tag {};
     struct bidirectional_iterator_tag : public forward_iterator_tag {};
     struct random_access_iterator_tag : public bidirectional_iterator_tag {};
+    // random access iterators whose elements are adjacent in memory, pointers among them
+    struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
     // iterator template
     template <class Category, class T, class Distance = ptrdiff_t, class Pointer = T*, class Reference = T&>
@@ -56,7 +59,7 @@ namespace tinystl {
 
     template <class T>
     struct iterator_traits<T*> {
-        typedef random_access_iterator_tag iterator_category;
+        typedef contiguous_iterator_tag iterator_category;
         typedef T value_type;
         typedef T* pointer;
         typedef T& reference;
@@ -65,7 +68,7 @@ namespace tinystl {
 
     template <class T>
     struct iterator_traits<const T*> {
-        typedef random_access_iterator_tag iterator_category;
+        typedef contiguous_iterator_tag iterator_category;
         typedef T value_type;
         typedef const T* pointer;
         typedef const T& reference;
@@ -87,11 +90,49 @@ namespace tinystl {
     struct is_bidirectional_iterator : public has_iterator_cat_of<Iter, bidirectional_iterator_tag> {};
     template <class Iter>
     struct is_random_access_iterator : public has_iterator_cat_of<Iter, random_access_iterator_tag> {};
+    template <class Iter>
+    struct is_contiguous_iterator : public has_iterator_cat_of<Iter, contiguous_iterator_tag> {};
 
     template <class Iterator>
     struct is_iterator : public bool_constant<is_input_iterator<Iterator>::value || is_output_iterator<Iterator>::value> {};
 
 
+    // address of the element at a contiguous iterator, valid at end too. by default taken from operator->,
+    // an iterator without a usable one specialises iterator_address
+    template <class Iter>
+    struct iterator_address {
+        static auto get(const Iter& it) noexcept -> decltype(it.operator->()) { return it.operator->(); }
+    };
+    template <class T>
+    struct iterator_address<T*> {
+        static T* get(T* p) noexcept { return p; }
+    };
+
+    template <class T>
+    constexpr T* to_address(T* p) noexcept { return p; }
+    template <class Iter>
+    auto to_address(const Iter& it) noexcept -> decltype(iterator_address<Iter>::get(it)) { return iterator_address<Iter>::get(it); }
+
+    // contiguous iterators are unwrapped to raw pointers so they reach the pointer fast paths,
+    // and the results are mapped back onto the caller's iterator
+    template <class Iter, bool = is_contiguous_iterator<Iter>::value && !std::is_pointer<Iter>::value>
+    struct iterator_unwrap {
+        typedef Iter type;
+        static type unwrap(const Iter& it) { return it; }
+        static Iter rewrap(const Iter&, const type& p) { return p; }
+    };
+    template <class Iter>
+    struct iterator_unwrap<Iter, true> {
+        typedef decltype(tinystl::to_address(std::declval<const Iter&>())) type;
+        static type unwrap(const Iter& it) { return tinystl::to_address(it); }
+        static Iter rewrap(const Iter& it, type p) { return it + (p - tinystl::to_address(it)); }
+    };
+
+    template <class Iter>
+    typename iterator_unwrap<Iter>::type unwrap_iter(const Iter& it) { return iterator_unwrap<Iter>::unwrap(it); }
+    template <class Iter>
+    Iter rewrap_iter(const Iter& it, typename iterator_unwrap<Iter>::type p) { return iterator_unwrap<Iter>::rewrap(it, p); }
+
     // template category
     template <class Iterator>
     typename iterator_traits<Iterator>::iterator_category iterator_category(const Iterator&) {
@@ -151,32 +192,53 @@ namespace tinystl {
     class reverse_iterator {
         private:
             Iterator current;
+            typedef typename iterator_traits<Iterator>::iterator_category base_category;
         public:
-            typedef typename iterator_traits<Iterator>::iterator_category iterator_category;
+            // reversed elements are no longer adjacent in increasing order, so at most random access
+            typedef typename std::conditional<std::is_convertible<base_category, contiguous_iterator_tag>::value,
+                random_access_iterator_tag, base_category>::type iterator_category;
             typedef typename iterator_traits<Iterator>::value_type value_type;
             typedef typename iterator_traits<Iterator>::difference_type difference_type;
             typedef typename iterator_traits<Iterator>::pointer pointer;
             typedef typename iterator_traits<Iterator>::reference reference;
-            typedef typename Iterator iterator_type;
-            typedef typename reverse_iterator<Iterator> self;
+            typedef Iterator iterator_type;
+            typedef reverse_iterator<Iterator> self;
 
             // constructor
-            reverse_iterator() {}
+            reverse_iterator() : current() {}
             explicit reverse_iterator(iterator_type i) : current(i) {}
             reverse_iterator(const self& rhs) : current(rhs.current) {}
+            template <class U>
+            reverse_iterator(const reverse_iterator<U>& rhs) : current(rhs.base()) {}
+            self& operator=(const self& rhs) { current = rhs.current; return *this; }
 
             iterator_type base() const { return current; }
             reference operator*() const { auto tmp = current; return *--tmp; }
             pointer operator->() const { return &(operator*()); }
             self& operator++() { --current; return *this; }
-            self& operator++(int) { self tmp = *this; --current; return tmp; }
+            self operator++(int) { self tmp = *this; --current; return tmp; }
             self& operator--() { ++current; return *this; }
-            self& operator--(int) { self tmp = *this; ++current; return tmp; }
+            self operator--(int) { self tmp = *this; ++current; return tmp; }
             self& operator+=(difference_type n) { current -= n; return *this; }
-            self& operator+(difference_type n) const { return self(current - n); }
+            self operator+(difference_type n) const { return self(current - n); }
             self& operator-=(difference_type n) { current += n; return *this; }
-            self& operator-(difference_type n) const { return self(current + n); }
-            self& operator[](difference_type n) { return *(*this + n); }
+            self operator-(difference_type n) const { return self(current + n); }
+            reference operator[](difference_type n) const { return *(*this + n); }
+    };
+
+    template <class Iterator>
+    reverse_iterator<Iterator> operator+(typename reverse_iterator<Iterator>::difference_type n, const reverse_iterator<Iterator>& it) {
+        return it + n;
+    }
+
+    // a reversed contiguous range unwraps to a reversed pointer range
+    template <class Iterator>
+    struct iterator_unwrap<reverse_iterator<Iterator>, false> {
+        typedef reverse_iterator<typename iterator_unwrap<Iterator>::type> type;
+        static type unwrap(const reverse_iterator<Iterator>& it) { return type(tinystl::unwrap_iter(it.base())); }
+        static reverse_iterator<Iterator> rewrap(const reverse_iterator<Iterator>& it, const type& p) {
+            return reverse_iterator<Iterator>(tinystl::rewrap_iter(it.base(), p.base()));
+        }
     };
 
     // overload operator-
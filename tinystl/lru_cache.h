@@ -0,0 +1,243 @@
+#ifndef TINYSTL_LRU_CACHE_H_
+#define TINYSTL_LRU_CACHE_H_
+
+// fixed capacity least recently used cache, all memory is allocated by the constructor
+
+#include <cstddef>
+#include <cstdint>
+
+#include "allocator.h"
+#include "construct.h"
+#include "exceptdef.h"
+#include "functional.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // class: lru cache
+    // entries live in one contiguous array linked by index into a recency list,
+    // an open addressing table (linear probing, backward shift erase) maps keys to entries
+    template <class Key, class Value, class Hash = tinystl::hash<Key>, class KeyEqual = tinystl::equal_to<Key>>
+    class lru_cache {
+    public:
+        typedef Key         key_type;
+        typedef Value       mapped_type;
+        typedef Hash        hasher;
+        typedef KeyEqual    key_equal;
+        typedef size_t      size_type;
+
+    private:
+        typedef uint32_t index_type;
+        static const index_type npos = static_cast<index_type>(-1);
+
+        struct node {
+            Key key;
+            Value value;
+            size_t hash;
+            index_type prev;
+            index_type next;
+        };
+
+        node* nodes;
+        index_type* table;
+        size_type table_mask;
+        size_type cap;
+        size_type len;
+        index_type head;    // most recently used
+        index_type tail;    // least recently used
+        index_type free_list;
+        size_type hit_count;
+        size_type miss_count;
+        size_type evict_count;
+        hasher hash;
+        key_equal equal;
+
+    public:
+        explicit lru_cache(size_type capacity, const hasher& hf = hasher(), const key_equal& eq = key_equal());
+        ~lru_cache() { clear(); tinystl::allocator<node>::deallocate(nodes, cap); tinystl::allocator<index_type>::deallocate(table, table_mask + 1); }
+
+    private:
+        lru_cache(const lru_cache&);
+        void operator=(const lru_cache&);
+
+    public:
+        // lookup and mark as most recently used, nullptr on a miss
+        Value* get(const key_type& key);
+        // lookup without touching recency or the counters
+        const Value* peek(const key_type& key) const;
+        bool contains(const key_type& key) const { return peek(key) != nullptr; }
+
+        // insert or overwrite, evicting the least recently used entry when full
+        template <class K, class V>
+        void put(K&& key, V&& value);
+        bool erase(const key_type& key);
+        void clear() noexcept;
+
+        size_type size() const noexcept { return len; }
+        size_type capacity() const noexcept { return cap; }
+        bool empty() const noexcept { return len == 0; }
+
+        size_type hits() const noexcept { return hit_count; }
+        size_type misses() const noexcept { return miss_count; }
+        size_type evictions() const noexcept { return evict_count; }
+        void reset_stats() noexcept { hit_count = miss_count = evict_count = 0; }
+
+    private:
+        size_t key_hash(const key_type& key) const { return static_cast<size_t>(tinystl::hash_mix(static_cast<uint64_t>(hash(key)))); }
+        size_type find_slot(const key_type& key, size_t h) const;
+        void erase_slot(size_type slot);
+        void unlink(index_type i) noexcept;
+        void push_front(index_type i) noexcept;
+        void release(index_type i);
+    };
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    const typename lru_cache<Key, Value, Hash, KeyEqual>::index_type lru_cache<Key, Value, Hash, KeyEqual>::npos;
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    lru_cache<Key, Value, Hash, KeyEqual>::lru_cache(size_type capacity, const hasher& hf, const key_equal& eq)
+        : nodes(nullptr), table(nullptr), table_mask(0), cap(capacity), len(0), head(npos), tail(npos), free_list(npos),
+          hit_count(0), miss_count(0), evict_count(0), hash(hf), equal(eq) {
+        THROW_LENGTH_ERROR_IF(capacity == 0 || capacity >= static_cast<size_type>(npos) / 2, "lru_cache capacity out of range");
+        // keep the table at most half full so probe sequences stay short
+        size_type slots = 2;
+        while (slots < capacity * 2) slots <<= 1;
+        table_mask = slots - 1;
+        table = tinystl::allocator<index_type>::allocate(slots);
+        try {
+            nodes = tinystl::allocator<node>::allocate(cap);
+        } catch (...) {
+            tinystl::allocator<index_type>::deallocate(table, slots);
+            throw;
+        }
+        for (size_type i = 0; i < slots; ++i) table[i] = npos;
+        for (size_type i = 0; i < cap; ++i) nodes[i].next = static_cast<index_type>(i + 1 < cap ? i + 1 : npos);
+        free_list = 0;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    typename lru_cache<Key, Value, Hash, KeyEqual>::size_type
+    lru_cache<Key, Value, Hash, KeyEqual>::find_slot(const key_type& key, size_t h) const {
+        size_type slot = h & table_mask;
+        while (table[slot] != npos) {
+            const node& n = nodes[table[slot]];
+            if (n.hash == h && equal(n.key, key)) return slot;
+            slot = (slot + 1) & table_mask;
+        }
+        return slot;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::erase_slot(size_type slot) {
+        // shift later members of the probe run back so lookups never stop early
+        size_type next = slot;
+        while (true) {
+            next = (next + 1) & table_mask;
+            if (table[next] == npos) break;
+            const size_type home = nodes[table[next]].hash & table_mask;
+            if (((next - home) & table_mask) >= ((next - slot) & table_mask)) {
+                table[slot] = table[next];
+                slot = next;
+            }
+        }
+        table[slot] = npos;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::unlink(index_type i) noexcept {
+        node& n = nodes[i];
+        if (n.prev != npos) nodes[n.prev].next = n.next; else head = n.next;
+        if (n.next != npos) nodes[n.next].prev = n.prev; else tail = n.prev;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::push_front(index_type i) noexcept {
+        node& n = nodes[i];
+        n.prev = npos;
+        n.next = head;
+        if (head != npos) nodes[head].prev = i; else tail = i;
+        head = i;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::release(index_type i) {
+        unlink(i);
+        tinystl::destroy(&nodes[i].key);
+        tinystl::destroy(&nodes[i].value);
+        nodes[i].next = free_list;
+        free_list = i;
+        --len;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    Value* lru_cache<Key, Value, Hash, KeyEqual>::get(const key_type& key) {
+        const index_type i = table[find_slot(key, key_hash(key))];
+        if (i == npos) { ++miss_count; return nullptr; }
+        ++hit_count;
+        if (i != head) { unlink(i); push_front(i); }
+        return &nodes[i].value;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    const Value* lru_cache<Key, Value, Hash, KeyEqual>::peek(const key_type& key) const {
+        const index_type i = table[find_slot(key, key_hash(key))];
+        return i == npos ? nullptr : &nodes[i].value;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    template <class K, class V>
+    void lru_cache<Key, Value, Hash, KeyEqual>::put(K&& key, V&& value) {
+        const size_t h = key_hash(key);
+        size_type slot = find_slot(key, h);
+        if (table[slot] != npos) {
+            const index_type i = table[slot];
+            nodes[i].value = tinystl::forward<V>(value);
+            if (i != head) { unlink(i); push_front(i); }
+            return;
+        }
+        if (len == cap) {
+            const index_type victim = tail;
+            erase_slot(find_slot(nodes[victim].key, nodes[victim].hash));
+            release(victim);
+            ++evict_count;
+            // the erase may have shifted entries, probe again for the free slot
+            slot = find_slot(key, h);
+        }
+        const index_type i = free_list;
+        node& n = nodes[i];
+        tinystl::construct(&n.key, tinystl::forward<K>(key));
+        try {
+            tinystl::construct(&n.value, tinystl::forward<V>(value));
+        } catch (...) {
+            tinystl::destroy(&n.key);
+            throw;
+        }
+        free_list = n.next;
+        n.hash = h;
+        table[slot] = i;
+        push_front(i);
+        ++len;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    bool lru_cache<Key, Value, Hash, KeyEqual>::erase(const key_type& key) {
+        const size_type slot = find_slot(key, key_hash(key));
+        const index_type i = table[slot];
+        if (i == npos) return false;
+        erase_slot(slot);
+        release(i);
+        return true;
+    }
+
+    template <class Key, class Value, class Hash, class KeyEqual>
+    void lru_cache<Key, Value, Hash, KeyEqual>::clear() noexcept {
+        while (head != npos) {
+            const index_type i = head;
+            erase_slot(find_slot(nodes[i].key, nodes[i].hash));
+            release(i);
+        }
+    }
+
+}
+
+#endif //TINYSTL_LRU_CACHE_H_
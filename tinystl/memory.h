@@ -1,9 +1,13 @@
 #ifndef TINYSTL_MEMORY_H_
 #define TINYSTL_MEMORY_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <climits>
+#include <cstdint>
+#include <exception>
+#include <new>
 
 #include "algobase.h"
 #include "allocator.h"
@@ -69,7 +73,7 @@ namespace tinystl {
 
     // constructor
     template <class ForwardIterator, class T>
-    temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last) {
+    temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last) : original_len(0), len(0), buffer(nullptr) {
         try {
             len = tinystl::distance(first, last);
             allocate_buffer();
@@ -93,6 +97,43 @@ namespace tinystl {
         }
     }
 
+    // class: scratch buffer
+    // exactly n elements from the allocator, std::bad_alloc rather than the shorter buffer a temporary_buffer settles for;
+    // types that are not trivially default constructible start as copies of value
+    template <class T>
+    class scratch_buffer {
+    private:
+        T* buffer;
+        ptrdiff_t len;
+
+    public:
+        scratch_buffer(ptrdiff_t n, const T& value) : buffer(tinystl::allocator<T>::allocate(static_cast<size_t>(n))), len(n) {
+            try {
+                initialize_buffer(value, std::is_trivially_default_constructible<T>());
+            } catch (...) {
+                tinystl::allocator<T>::deallocate(buffer, static_cast<size_t>(len));
+                throw;
+            }
+        }
+        ~scratch_buffer() {
+            tinystl::destroy(buffer, buffer + len);
+            tinystl::allocator<T>::deallocate(buffer, static_cast<size_t>(len));
+        }
+
+    public:
+        ptrdiff_t size() const noexcept { return len; }
+        T* begin() noexcept { return buffer; }
+        T* end() noexcept { return buffer + len; }
+
+    private:
+        void initialize_buffer(const T&, std::true_type) {}
+        void initialize_buffer(const T& value, std::false_type) { tinystl::uninitialized_fill_n(buffer, len, value); }
+
+    private:
+        scratch_buffer(const scratch_buffer&);
+        void operator=(const scratch_buffer&);
+    };
+
     // class: auto_ptr
     template <class T>
     class auto_ptr {
@@ -139,6 +180,495 @@ namespace tinystl {
         }
     };
 
+    // default delete
+    template <class T>
+    struct default_delete {
+        constexpr default_delete() noexcept = default;
+        template <class U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        default_delete(const default_delete<U>&) noexcept {}
+        void operator()(T* ptr) const { static_assert(sizeof(T) > 0, "can't delete an incomplete type"); delete ptr; }
+    };
+    template <class T>
+    struct default_delete<T[]> {
+        constexpr default_delete() noexcept = default;
+        void operator()(T* ptr) const { static_assert(sizeof(T) > 0, "can't delete an incomplete type"); delete[] ptr; }
+    };
+
+    // std::is_final is c++14, the compiler builtin behind it is older
+#if __cplusplus >= 201402L
+    template <class T>
+    struct is_final_class : std::is_final<T> {};
+#else
+    template <class T>
+    struct is_final_class : std::integral_constant<bool, __is_final(T)> {};
+#endif
+
+    // pointer + deleter, an empty deleter is a base class and takes no space; a final one can't be derived from
+    template <class T, class Deleter, bool = std::is_empty<Deleter>::value && !is_final_class<Deleter>::value>
+    class unique_ptr_storage : private Deleter {
+    public:
+        T* m_ptr;
+        unique_ptr_storage() : Deleter(), m_ptr(nullptr) {}
+        template <class D>
+        unique_ptr_storage(T* p, D&& d) : Deleter(tinystl::forward<D>(d)), m_ptr(p) {}
+        Deleter& deleter() noexcept { return *this; }
+        const Deleter& deleter() const noexcept { return *this; }
+    };
+    template <class T, class Deleter>
+    class unique_ptr_storage<T, Deleter, false> {
+    private:
+        Deleter m_deleter;
+    public:
+        T* m_ptr;
+        unique_ptr_storage() : m_deleter(), m_ptr(nullptr) {}
+        template <class D>
+        unique_ptr_storage(T* p, D&& d) : m_deleter(tinystl::forward<D>(d)), m_ptr(p) {}
+        Deleter& deleter() noexcept { return m_deleter; }
+        const Deleter& deleter() const noexcept { return m_deleter; }
+    };
+
+    // class: unique_ptr
+    template <class T, class Deleter = default_delete<T>>
+    class unique_ptr {
+    public:
+        typedef T*          pointer;
+        typedef T           element_type;
+        typedef Deleter     deleter_type;
+    private:
+        unique_ptr_storage<T, Deleter> m_storage;
+    public:
+        constexpr unique_ptr() noexcept : m_storage() {}
+        constexpr unique_ptr(std::nullptr_t) noexcept : m_storage() {}
+        explicit unique_ptr(T* p) noexcept : m_storage(p, Deleter()) {}
+        unique_ptr(T* p, const Deleter& d) noexcept : m_storage(p, d) {}
+        unique_ptr(T* p, typename std::remove_reference<Deleter>::type&& d) noexcept : m_storage(p, tinystl::move(d)) {}
+        unique_ptr(unique_ptr&& rhs) noexcept : m_storage(rhs.release(), tinystl::forward<Deleter>(rhs.get_deleter())) {}
+        template <class U, class E, typename = typename std::enable_if<std::is_convertible<U*, T*>::value && !std::is_array<U>::value>::type>
+        unique_ptr(unique_ptr<U, E>&& rhs) noexcept : m_storage(rhs.release(), tinystl::forward<E>(rhs.get_deleter())) {}
+        ~unique_ptr() { if (m_storage.m_ptr) get_deleter()(m_storage.m_ptr); }
+
+        unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+            reset(rhs.release());
+            get_deleter() = tinystl::forward<Deleter>(rhs.get_deleter());
+            return *this;
+        }
+        template <class U, class E>
+        unique_ptr& operator=(unique_ptr<U, E>&& rhs) noexcept {
+            reset(rhs.release());
+            get_deleter() = tinystl::forward<E>(rhs.get_deleter());
+            return *this;
+        }
+        unique_ptr& operator=(std::nullptr_t) noexcept { reset(); return *this; }
+
+    private:
+        unique_ptr(const unique_ptr&);
+        void operator=(const unique_ptr&);
+
+    public:
+        T& operator*() const { return *m_storage.m_ptr; }
+        T* operator->() const noexcept { return m_storage.m_ptr; }
+        T* get() const noexcept { return m_storage.m_ptr; }
+        Deleter& get_deleter() noexcept { return m_storage.deleter(); }
+        const Deleter& get_deleter() const noexcept { return m_storage.deleter(); }
+        explicit operator bool() const noexcept { return m_storage.m_ptr != nullptr; }
+
+        T* release() noexcept { T* tmp = m_storage.m_ptr; m_storage.m_ptr = nullptr; return tmp; }
+        void reset(T* p = nullptr) noexcept {
+            T* old = m_storage.m_ptr;
+            m_storage.m_ptr = p;
+            if (old) get_deleter()(old);
+        }
+        void swap(unique_ptr& rhs) noexcept {
+            tinystl::swap(m_storage.m_ptr, rhs.m_storage.m_ptr);
+            tinystl::swap(get_deleter(), rhs.get_deleter());
+        }
+    };
+
+    template <class T, class Deleter>
+    class unique_ptr<T[], Deleter> {
+    public:
+        typedef T*          pointer;
+        typedef T           element_type;
+        typedef Deleter     deleter_type;
+    private:
+        unique_ptr_storage<T, Deleter> m_storage;
+    public:
+        constexpr unique_ptr() noexcept : m_storage() {}
+        constexpr unique_ptr(std::nullptr_t) noexcept : m_storage() {}
+        explicit unique_ptr(T* p) noexcept : m_storage(p, Deleter()) {}
+        unique_ptr(T* p, const Deleter& d) noexcept : m_storage(p, d) {}
+        unique_ptr(T* p, typename std::remove_reference<Deleter>::type&& d) noexcept : m_storage(p, tinystl::move(d)) {}
+        unique_ptr(unique_ptr&& rhs) noexcept : m_storage(rhs.release(), tinystl::forward<Deleter>(rhs.get_deleter())) {}
+        ~unique_ptr() { if (m_storage.m_ptr) get_deleter()(m_storage.m_ptr); }
+
+        unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+            reset(rhs.release());
+            get_deleter() = tinystl::forward<Deleter>(rhs.get_deleter());
+            return *this;
+        }
+        unique_ptr& operator=(std::nullptr_t) noexcept { reset(); return *this; }
+
+    private:
+        unique_ptr(const unique_ptr&);
+        void operator=(const unique_ptr&);
+
+    public:
+        T& operator[](size_t i) const { return m_storage.m_ptr[i]; }
+        T* get() const noexcept { return m_storage.m_ptr; }
+        Deleter& get_deleter() noexcept { return m_storage.deleter(); }
+        const Deleter& get_deleter() const noexcept { return m_storage.deleter(); }
+        explicit operator bool() const noexcept { return m_storage.m_ptr != nullptr; }
+
+        T* release() noexcept { T* tmp = m_storage.m_ptr; m_storage.m_ptr = nullptr; return tmp; }
+        void reset(T* p = nullptr) noexcept {
+            T* old = m_storage.m_ptr;
+            m_storage.m_ptr = p;
+            if (old) get_deleter()(old);
+        }
+        void swap(unique_ptr& rhs) noexcept {
+            tinystl::swap(m_storage.m_ptr, rhs.m_storage.m_ptr);
+            tinystl::swap(get_deleter(), rhs.get_deleter());
+        }
+    };
+
+    template <class T, class D>
+    void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept { lhs.swap(rhs); }
+    template <class T1, class D1, class T2, class D2>
+    bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) { return lhs.get() == rhs.get(); }
+    template <class T1, class D1, class T2, class D2>
+    bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) { return lhs.get() != rhs.get(); }
+    template <class T, class D>
+    bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) { return !lhs; }
+    template <class T, class D>
+    bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) { return static_cast<bool>(lhs); }
+
+    // make unique
+    template <class T, class... Args>
+    typename std::enable_if<!std::is_array<T>::value, unique_ptr<T>>::type make_unique(Args&&... args) {
+        return unique_ptr<T>(new T(tinystl::forward<Args>(args)...));
+    }
+    template <class T>
+    typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, unique_ptr<T>>::type make_unique(size_t n) {
+        return unique_ptr<T>(new typename std::remove_extent<T>::type[n]());
+    }
+
+    // reference count policies: shared_atomic for objects shared between threads,
+    // shared_local for thread confined object graphs where the atomic read-modify-write is pure overhead
+    struct shared_atomic {
+        typedef std::atomic<long> count_type;
+        static void increment(count_type& c) noexcept { c.fetch_add(1, std::memory_order_relaxed); }
+        static long decrement(count_type& c) noexcept { return c.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+        static long load(const count_type& c) noexcept { return c.load(std::memory_order_acquire); }
+        static bool increment_if_nonzero(count_type& c) noexcept {
+            long n = c.load(std::memory_order_relaxed);
+            while (n != 0) {
+                if (c.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel, std::memory_order_relaxed)) return true;
+            }
+            return false;
+        }
+    };
+    struct shared_local {
+        typedef long count_type;
+        static void increment(count_type& c) noexcept { ++c; }
+        static long decrement(count_type& c) noexcept { return --c; }
+        static long load(const count_type& c) noexcept { return c; }
+        static bool increment_if_nonzero(count_type& c) noexcept { if (c == 0) return false; ++c; return true; }
+    };
+
+    class bad_weak_ptr : public std::exception {
+    public:
+        const char* what() const noexcept { return "tinystl::bad_weak_ptr"; }
+    };
+
+    // shared control block, weaks counts the weak owners plus one while any shared owner is alive
+    template <class Policy>
+    class shared_count_base {
+    private:
+        typename Policy::count_type uses;
+        typename Policy::count_type weaks;
+    public:
+        shared_count_base() noexcept : uses(1), weaks(1) {}
+        virtual ~shared_count_base() {}
+        virtual void dispose() noexcept = 0;    // destroy the managed object
+        virtual void destroy() noexcept = 0;    // free the control block
+
+        void add_ref() noexcept { Policy::increment(uses); }
+        bool add_ref_lock() noexcept { return Policy::increment_if_nonzero(uses); }
+        void release() noexcept { if (Policy::decrement(uses) == 0) { dispose(); weak_release(); } }
+        void weak_add_ref() noexcept { Policy::increment(weaks); }
+        void weak_release() noexcept { if (Policy::decrement(weaks) == 0) destroy(); }
+        long use_count() const noexcept { return Policy::load(uses); }
+    private:
+        shared_count_base(const shared_count_base&);
+        void operator=(const shared_count_base&);
+    };
+
+    // control block for a separately allocated object
+    template <class T, class Deleter, class Policy>
+    class shared_count_ptr : public shared_count_base<Policy> {
+    private:
+        unique_ptr_storage<T, Deleter> m_storage;
+    public:
+        shared_count_ptr(T* p, Deleter d) : m_storage(p, tinystl::move(d)) {}
+        void dispose() noexcept { m_storage.deleter()(m_storage.m_ptr); }
+        void destroy() noexcept { delete this; }
+    };
+
+    // control block with the object stored inline, so make_shared needs one allocation
+    template <class T, class Policy, bool = (alignof(T) > alignof(std::max_align_t))>
+    class shared_count_inplace : public shared_count_base<Policy> {
+    private:
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+    public:
+        template <class... Args>
+        explicit shared_count_inplace(Args&&... args) { ::new (static_cast<void*>(&m_storage)) T(tinystl::forward<Args>(args)...); }
+        T* get() noexcept { return reinterpret_cast<T*>(&m_storage); }
+        void dispose() noexcept { get()->~T(); }
+        void destroy() noexcept { delete this; }
+    };
+
+    // over aligned object: c++11 operator new only honours alignof(max_align_t), so the block
+    // holds alignof(T) - 1 spare bytes and the object starts at the first aligned address
+    template <class T, class Policy>
+    class shared_count_inplace<T, Policy, true> : public shared_count_base<Policy> {
+    private:
+        unsigned char m_storage[sizeof(T) + alignof(T) - 1];
+        T* m_object;
+    public:
+        template <class... Args>
+        explicit shared_count_inplace(Args&&... args) {
+            const uintptr_t addr = (reinterpret_cast<uintptr_t>(m_storage) + alignof(T) - 1) & ~static_cast<uintptr_t>(alignof(T) - 1);
+            m_object = ::new (reinterpret_cast<void*>(addr)) T(tinystl::forward<Args>(args)...);
+        }
+        T* get() noexcept { return m_object; }
+        void dispose() noexcept { m_object->~T(); }
+        void destroy() noexcept { delete this; }
+    };
+
+    template <class T, class Policy> class weak_ptr;
+
+    // class: shared_ptr
+    template <class T, class Policy = shared_atomic>
+    class shared_ptr {
+    public:
+        typedef T element_type;
+        typedef weak_ptr<T, Policy> weak_type;
+    private:
+        T* m_ptr;
+        shared_count_base<Policy>* m_count;
+
+        template <class U, class P> friend class shared_ptr;
+        template <class U, class P> friend class weak_ptr;
+        template <class U, class P, class... Args> friend shared_ptr<U, P> allocate_shared_inplace(Args&&... args);
+
+    public:
+        constexpr shared_ptr() noexcept : m_ptr(nullptr), m_count(nullptr) {}
+        constexpr shared_ptr(std::nullptr_t) noexcept : m_ptr(nullptr), m_count(nullptr) {}
+        template <class U>
+        explicit shared_ptr(U* p) : m_ptr(p), m_count(nullptr) {
+            try { m_count = new shared_count_ptr<U, default_delete<U>, Policy>(p, default_delete<U>()); }
+            catch (...) { delete p; throw; }
+        }
+        template <class U, class Deleter>
+        shared_ptr(U* p, Deleter d) : m_ptr(p), m_count(nullptr) {
+            try { m_count = new shared_count_ptr<U, Deleter, Policy>(p, d); }
+            catch (...) { d(p); throw; }
+        }
+        template <class U, class Deleter>
+        shared_ptr(unique_ptr<U, Deleter>&& rhs) : m_ptr(rhs.get()), m_count(nullptr) {
+            if (m_ptr) {
+                m_count = new shared_count_ptr<U, Deleter, Policy>(rhs.get(), tinystl::forward<Deleter>(rhs.get_deleter()));
+                rhs.release();
+            }
+        }
+        // aliasing: shares ownership with rhs but points at p
+        template <class U>
+        shared_ptr(const shared_ptr<U, Policy>& rhs, T* p) noexcept : m_ptr(p), m_count(rhs.m_count) { if (m_count) m_count->add_ref(); }
+        shared_ptr(const shared_ptr& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { if (m_count) m_count->add_ref(); }
+        template <class U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        shared_ptr(const shared_ptr<U, Policy>& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { if (m_count) m_count->add_ref(); }
+        shared_ptr(shared_ptr&& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { rhs.m_ptr = nullptr; rhs.m_count = nullptr; }
+        template <class U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        shared_ptr(shared_ptr<U, Policy>&& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { rhs.m_ptr = nullptr; rhs.m_count = nullptr; }
+        template <class U>
+        explicit shared_ptr(const weak_ptr<U, Policy>& rhs) : m_ptr(rhs.m_ptr), m_count(rhs.m_count) {
+            if (!m_count || !m_count->add_ref_lock()) throw bad_weak_ptr();
+        }
+        ~shared_ptr() { if (m_count) m_count->release(); }
+
+        shared_ptr& operator=(const shared_ptr& rhs) noexcept { shared_ptr(rhs).swap(*this); return *this; }
+        template <class U>
+        shared_ptr& operator=(const shared_ptr<U, Policy>& rhs) noexcept { shared_ptr(rhs).swap(*this); return *this; }
+        shared_ptr& operator=(shared_ptr&& rhs) noexcept { shared_ptr(tinystl::move(rhs)).swap(*this); return *this; }
+        template <class U>
+        shared_ptr& operator=(shared_ptr<U, Policy>&& rhs) noexcept { shared_ptr(tinystl::move(rhs)).swap(*this); return *this; }
+        template <class U, class Deleter>
+        shared_ptr& operator=(unique_ptr<U, Deleter>&& rhs) { shared_ptr(tinystl::move(rhs)).swap(*this); return *this; }
+
+    public:
+        T& operator*() const noexcept { return *m_ptr; }
+        T* operator->() const noexcept { return m_ptr; }
+        T* get() const noexcept { return m_ptr; }
+        long use_count() const noexcept { return m_count ? m_count->use_count() : 0; }
+        bool unique() const noexcept { return use_count() == 1; }
+        explicit operator bool() const noexcept { return m_ptr != nullptr; }
+
+        void reset() noexcept { shared_ptr().swap(*this); }
+        template <class U>
+        void reset(U* p) { shared_ptr(p).swap(*this); }
+        template <class U, class Deleter>
+        void reset(U* p, Deleter d) { shared_ptr(p, d).swap(*this); }
+
+        void swap(shared_ptr& rhs) noexcept { tinystl::swap(m_ptr, rhs.m_ptr); tinystl::swap(m_count, rhs.m_count); }
+
+        template <class U>
+        bool owner_before(const shared_ptr<U, Policy>& rhs) const noexcept { return m_count < rhs.m_count; }
+        template <class U>
+        bool owner_before(const weak_ptr<U, Policy>& rhs) const noexcept { return m_count < rhs.m_count; }
+    };
+
+    template <class T, class P>
+    void swap(shared_ptr<T, P>& lhs, shared_ptr<T, P>& rhs) noexcept { lhs.swap(rhs); }
+    template <class T, class U, class P>
+    bool operator==(const shared_ptr<T, P>& lhs, const shared_ptr<U, P>& rhs) { return lhs.get() == rhs.get(); }
+    template <class T, class U, class P>
+    bool operator!=(const shared_ptr<T, P>& lhs, const shared_ptr<U, P>& rhs) { return lhs.get() != rhs.get(); }
+    template <class T, class P>
+    bool operator==(const shared_ptr<T, P>& lhs, std::nullptr_t) { return !lhs; }
+    template <class T, class P>
+    bool operator!=(const shared_ptr<T, P>& lhs, std::nullptr_t) { return static_cast<bool>(lhs); }
+
+    template <class T, class U, class P>
+    shared_ptr<T, P> static_pointer_cast(const shared_ptr<U, P>& rhs) noexcept { return shared_ptr<T, P>(rhs, static_cast<T*>(rhs.get())); }
+    template <class T, class U, class P>
+    shared_ptr<T, P> dynamic_pointer_cast(const shared_ptr<U, P>& rhs) noexcept {
+        T* p = dynamic_cast<T*>(rhs.get());
+        return p ? shared_ptr<T, P>(rhs, p) : shared_ptr<T, P>();
+    }
+    template <class T, class U, class P>
+    shared_ptr<T, P> const_pointer_cast(const shared_ptr<U, P>& rhs) noexcept { return shared_ptr<T, P>(rhs, const_cast<T*>(rhs.get())); }
+
+    // class: weak_ptr
+    template <class T, class Policy = shared_atomic>
+    class weak_ptr {
+    public:
+        typedef T element_type;
+    private:
+        T* m_ptr;
+        shared_count_base<Policy>* m_count;
+
+        template <class U, class P> friend class shared_ptr;
+        template <class U, class P> friend class weak_ptr;
+
+    public:
+        constexpr weak_ptr() noexcept : m_ptr(nullptr), m_count(nullptr) {}
+        weak_ptr(const weak_ptr& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { if (m_count) m_count->weak_add_ref(); }
+        template <class U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        weak_ptr(const weak_ptr<U, Policy>& rhs) noexcept : m_ptr(rhs.lock().get()), m_count(rhs.m_count) { if (m_count) m_count->weak_add_ref(); }
+        template <class U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        weak_ptr(const shared_ptr<U, Policy>& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { if (m_count) m_count->weak_add_ref(); }
+        weak_ptr(weak_ptr&& rhs) noexcept : m_ptr(rhs.m_ptr), m_count(rhs.m_count) { rhs.m_ptr = nullptr; rhs.m_count = nullptr; }
+        ~weak_ptr() { if (m_count) m_count->weak_release(); }
+
+        weak_ptr& operator=(const weak_ptr& rhs) noexcept { weak_ptr(rhs).swap(*this); return *this; }
+        weak_ptr& operator=(weak_ptr&& rhs) noexcept { weak_ptr(tinystl::move(rhs)).swap(*this); return *this; }
+        template <class U>
+        weak_ptr& operator=(const shared_ptr<U, Policy>& rhs) noexcept { weak_ptr(rhs).swap(*this); return *this; }
+
+    public:
+        long use_count() const noexcept { return m_count ? m_count->use_count() : 0; }
+        bool expired() const noexcept { return use_count() == 0; }
+        shared_ptr<T, Policy> lock() const noexcept {
+            shared_ptr<T, Policy> result;
+            if (m_count && m_count->add_ref_lock()) { result.m_ptr = m_ptr; result.m_count = m_count; }
+            return result;
+        }
+        void reset() noexcept { weak_ptr().swap(*this); }
+        void swap(weak_ptr& rhs) noexcept { tinystl::swap(m_ptr, rhs.m_ptr); tinystl::swap(m_count, rhs.m_count); }
+
+        template <class U>
+        bool owner_before(const shared_ptr<U, Policy>& rhs) const noexcept { return m_count < rhs.m_count; }
+        template <class U>
+        bool owner_before(const weak_ptr<U, Policy>& rhs) const noexcept { return m_count < rhs.m_count; }
+    };
+
+    template <class T, class P>
+    void swap(weak_ptr<T, P>& lhs, weak_ptr<T, P>& rhs) noexcept { lhs.swap(rhs); }
+
+    // thread confined shared ownership, non atomic reference counts
+    template <class T>
+    using local_shared_ptr = shared_ptr<T, shared_local>;
+    template <class T>
+    using local_weak_ptr = weak_ptr<T, shared_local>;
+
+    // make shared: control block and object in one allocation
+    template <class T, class Policy, class... Args>
+    shared_ptr<T, Policy> allocate_shared_inplace(Args&&... args) {
+        shared_count_inplace<T, Policy>* block = new shared_count_inplace<T, Policy>(tinystl::forward<Args>(args)...);
+        shared_ptr<T, Policy> result;
+        result.m_ptr = block->get();
+        result.m_count = block;
+        return result;
+    }
+    template <class T, class... Args>
+    shared_ptr<T> make_shared(Args&&... args) { return tinystl::allocate_shared_inplace<T, shared_atomic>(tinystl::forward<Args>(args)...); }
+    template <class T, class... Args>
+    local_shared_ptr<T> make_local_shared(Args&&... args) { return tinystl::allocate_shared_inplace<T, shared_local>(tinystl::forward<Args>(args)...); }
+
+    // intrusive reference counter base, Derived gets intrusive_ptr_add_ref / intrusive_ptr_release found by ADL
+    template <class Derived, class Policy = shared_atomic>
+    class intrusive_ref_counter {
+    private:
+        mutable typename Policy::count_type m_refs;
+    protected:
+        intrusive_ref_counter() noexcept : m_refs(0) {}
+        intrusive_ref_counter(const intrusive_ref_counter&) noexcept : m_refs(0) {}
+        intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept { return *this; }
+        ~intrusive_ref_counter() {}
+    public:
+        long use_count() const noexcept { return Policy::load(m_refs); }
+        friend void intrusive_ptr_add_ref(const Derived* p) noexcept { Policy::increment(p->m_refs); }
+        friend void intrusive_ptr_release(const Derived* p) noexcept { if (Policy::decrement(p->m_refs) == 0) delete p; }
+    };
+
+    // class: intrusive_ptr, the count lives in the object itself
+    template <class T>
+    class intrusive_ptr {
+    public:
+        typedef T element_type;
+    private:
+        T* m_ptr;
+    public:
+        constexpr intrusive_ptr() noexcept : m_ptr(nullptr) {}
+        intrusive_ptr(T* p, bool add_ref = true) : m_ptr(p) { if (m_ptr && add_ref) intrusive_ptr_add_ref(m_ptr); }
+        intrusive_ptr(const intrusive_ptr& rhs) : m_ptr(rhs.m_ptr) { if (m_ptr) intrusive_ptr_add_ref(m_ptr); }
+        template <class U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+        intrusive_ptr(const intrusive_ptr<U>& rhs) : m_ptr(rhs.get()) { if (m_ptr) intrusive_ptr_add_ref(m_ptr); }
+        intrusive_ptr(intrusive_ptr&& rhs) noexcept : m_ptr(rhs.m_ptr) { rhs.m_ptr = nullptr; }
+        ~intrusive_ptr() { if (m_ptr) intrusive_ptr_release(m_ptr); }
+
+        intrusive_ptr& operator=(const intrusive_ptr& rhs) { intrusive_ptr(rhs).swap(*this); return *this; }
+        intrusive_ptr& operator=(intrusive_ptr&& rhs) noexcept { intrusive_ptr(tinystl::move(rhs)).swap(*this); return *this; }
+        intrusive_ptr& operator=(T* p) { intrusive_ptr(p).swap(*this); return *this; }
+
+    public:
+        T& operator*() const noexcept { return *m_ptr; }
+        T* operator->() const noexcept { return m_ptr; }
+        T* get() const noexcept { return m_ptr; }
+        T* detach() noexcept { T* tmp = m_ptr; m_ptr = nullptr; return tmp; }
+        explicit operator bool() const noexcept { return m_ptr != nullptr; }
+        void reset() { intrusive_ptr().swap(*this); }
+        void reset(T* p) { intrusive_ptr(p).swap(*this); }
+        void swap(intrusive_ptr& rhs) noexcept { tinystl::swap(m_ptr, rhs.m_ptr); }
+    };
+
+    template <class T>
+    void swap(intrusive_ptr<T>& lhs, intrusive_ptr<T>& rhs) noexcept { lhs.swap(rhs); }
+    template <class T, class U>
+    bool operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) { return lhs.get() == rhs.get(); }
+    template <class T, class U>
+    bool operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) { return lhs.get() != rhs.get(); }
+
 }
 
 #endif //TINYSTL_MEMORY_H_
@@ -0,0 +1,404 @@
+#ifndef TINYSTL_MERGE_H_
+#define TINYSTL_MERGE_H_
+
+// merging sorted ranges: galloping two way merge, rotate, a buffer adaptive inplace merge
+// and a loser tree k way merge
+
+#include <cstddef>
+
+#include "algobase.h"
+#include "binary_search.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "sort_network.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // a merge switches to galloping once one input wins this many times in a row
+    const ptrdiff_t merge_min_gallop = 7;
+    // inputs of integer keys up to this many elements in total take the fixed trip count merge
+    const size_t merge_network_threshold = 16;
+
+    // galloping: probe at distances 1, 3, 7, 15... from one end, then binary search the last step,
+    // so finding a boundary k elements away costs O(log k) instead of O(log n)
+    template <class RandomIter, class T, class Compared>
+    RandomIter gallop_lower_bound(RandomIter first, RandomIter last, const T& value, Compared comp) {
+        const auto n = last - first;
+        decltype(last - first) lo = 0, hi = 1;
+        while (hi <= n && comp(*(first + (hi - 1)), value)) { lo = hi; hi = hi * 2 + 1; }
+        return tinystl::lower_bound(first + lo, first + (hi <= n ? hi - 1 : n), value, comp);
+    }
+
+    template <class RandomIter, class T, class Compared>
+    RandomIter gallop_upper_bound(RandomIter first, RandomIter last, const T& value, Compared comp) {
+        const auto n = last - first;
+        decltype(last - first) lo = 0, hi = 1;
+        while (hi <= n && !comp(value, *(first + (hi - 1)))) { lo = hi; hi = hi * 2 + 1; }
+        return tinystl::upper_bound(first + lo, first + (hi <= n ? hi - 1 : n), value, comp);
+    }
+
+    template <class RandomIter, class T, class Compared>
+    RandomIter gallop_lower_bound_back(RandomIter first, RandomIter last, const T& value, Compared comp) {
+        const auto n = last - first;
+        decltype(last - first) lo = 0, hi = 1;
+        while (hi <= n && !comp(*(last - hi), value)) { lo = hi; hi = hi * 2 + 1; }
+        return tinystl::lower_bound(hi <= n ? last - (hi - 1) : first, last - lo, value, comp);
+    }
+
+    template <class RandomIter, class T, class Compared>
+    RandomIter gallop_upper_bound_back(RandomIter first, RandomIter last, const T& value, Compared comp) {
+        const auto n = last - first;
+        decltype(last - first) lo = 0, hi = 1;
+        while (hi <= n && comp(value, *(last - hi))) { lo = hi; hi = hi * 2 + 1; }
+        return tinystl::upper_bound(hi <= n ? last - (hi - 1) : first, last - lo, value, comp);
+    }
+
+    // merge
+    template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+    OutputIter merge_cat(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp, tinystl::input_iterator_tag) {
+        while (first1 != last1 && first2 != last2) {
+            if (comp(*first2, *first1)) { *result = *first2; ++first2; }
+            else { *result = *first1; ++first1; }
+            ++result;
+        }
+        return tinystl::copy(first2, last2, tinystl::copy(first1, last1, result));
+    }
+
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    bool merge_network(RandomIter1, RandomIter1, RandomIter2, RandomIter2, OutputIter&, Compared, tinystl::false_type) {
+        return false;
+    }
+
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    bool merge_network(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2, OutputIter& result, Compared comp, tinystl::true_type) {
+        const size_t n1 = static_cast<size_t>(last1 - first1), n2 = static_cast<size_t>(last2 - first2);
+        if (n1 + n2 > merge_network_threshold) return false;
+        result = tinystl::rewrap_iter(result, tinystl::network_merge_small(tinystl::unwrap_iter(first1), n1,
+            tinystl::unwrap_iter(first2), n2, tinystl::unwrap_iter(result), comp));
+        return true;
+    }
+
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    OutputIter merge_cat(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2, OutputIter result, Compared comp, tinystl::random_access_iterator_tag) {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        typedef bool_constant<is_network_mergeable<value_type, Compared>::value &&
+            std::is_same<value_type, typename iterator_traits<RandomIter2>::value_type>::value> network;
+        if (tinystl::merge_network(first1, last1, first2, last2, result, comp, network())) return result;
+        ptrdiff_t streak1 = 0, streak2 = 0;
+        while (first1 != last1 && first2 != last2) {
+            if (comp(*first2, *first1)) {
+                *result = *first2; ++first2; ++result;
+                streak1 = 0;
+                if (++streak2 >= merge_min_gallop) {
+                    const RandomIter2 run = tinystl::gallop_lower_bound(first2, last2, *first1, comp);
+                    result = tinystl::copy(first2, run, result);
+                    first2 = run;
+                    streak2 = 0;
+                }
+            } else {
+                *result = *first1; ++first1; ++result;
+                streak2 = 0;
+                if (++streak1 >= merge_min_gallop) {
+                    const RandomIter1 run = tinystl::gallop_upper_bound(first1, last1, *first2, comp);
+                    result = tinystl::copy(first1, run, result);
+                    first1 = run;
+                    streak1 = 0;
+                }
+            }
+        }
+        return tinystl::copy(first2, last2, tinystl::copy(first1, last1, result));
+    }
+
+    // stable: of two equivalent elements the one from the first range is written first
+    template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+    OutputIter merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+        typedef typename std::conditional<
+            std::is_convertible<typename iterator_traits<InputIter1>::iterator_category, random_access_iterator_tag>::value &&
+            std::is_convertible<typename iterator_traits<InputIter2>::iterator_category, random_access_iterator_tag>::value,
+            random_access_iterator_tag, input_iterator_tag>::type category;
+        return tinystl::merge_cat(first1, last1, first2, last2, result, comp, category());
+    }
+
+    template <class InputIter1, class InputIter2, class OutputIter>
+    OutputIter merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+        return tinystl::merge(first1, last1, first2, last2, result, tinystl::less<typename iterator_traits<InputIter1>::value_type>());
+    }
+
+    // rotate: swap blocks until the shorter side is exhausted, returns the new position of *first
+    template <class ForwardIter>
+    ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last) {
+        if (first == middle) return last;
+        if (middle == last) return first;
+        ForwardIter next = middle;
+        do {
+            tinystl::iter_swap(first, next);
+            ++first; ++next;
+            if (first == middle) middle = next;
+        } while (next != last);
+        // the first pass fixed the answer, the rest only reorders the tail
+        ForwardIter result = first;
+        next = middle;
+        while (next != last) {
+            tinystl::iter_swap(first, next);
+            ++first; ++next;
+            if (first == middle) middle = next;
+            else if (next == last) next = middle;
+        }
+        return result;
+    }
+
+    // rotate through the buffer when the shorter side fits
+    template <class RandomIter, class Pointer, class Distance>
+    RandomIter rotate_adaptive(RandomIter first, RandomIter middle, RandomIter last, Distance len1, Distance len2, Pointer buffer, Distance buffer_size) {
+        if (len2 <= len1 && len2 <= buffer_size) {
+            if (len2 == 0) return first;
+            Pointer buffer_end = tinystl::move(middle, last, buffer);
+            tinystl::move_backward(first, middle, last);
+            return tinystl::move(buffer, buffer_end, first);
+        }
+        if (len1 <= buffer_size) {
+            if (len1 == 0) return last;
+            Pointer buffer_end = tinystl::move(first, middle, buffer);
+            tinystl::move(middle, last, first);
+            return tinystl::move_backward(buffer, buffer_end, last);
+        }
+        return tinystl::rotate(first, middle, last);
+    }
+
+    // merge the left run, moved out to the buffer, with the right run in place, front to back
+    template <class Pointer, class RandomIter, class Compared>
+    void merge_forward(Pointer buf, Pointer buf_end, RandomIter right, RandomIter last, RandomIter result, Compared comp) {
+        ptrdiff_t streak_l = 0, streak_r = 0;
+        while (buf != buf_end && right != last) {
+            if (comp(*right, *buf)) {
+                *result = tinystl::move(*right); ++right; ++result;
+                streak_l = 0;
+                if (++streak_r >= merge_min_gallop) {
+                    const RandomIter run = tinystl::gallop_lower_bound(right, last, *buf, comp);
+                    result = tinystl::move(right, run, result);
+                    right = run;
+                    streak_r = 0;
+                }
+            } else {
+                *result = tinystl::move(*buf); ++buf; ++result;
+                streak_r = 0;
+                if (++streak_l >= merge_min_gallop) {
+                    const Pointer run = tinystl::gallop_upper_bound(buf, buf_end, *right, comp);
+                    result = tinystl::move(buf, run, result);
+                    buf = run;
+                    streak_l = 0;
+                }
+            }
+        }
+        // whatever is left of the right run is already in place
+        tinystl::move(buf, buf_end, result);
+    }
+
+    // merge the left run in place with the right run, moved out to the buffer, back to front
+    template <class RandomIter, class Pointer, class Compared>
+    void merge_backward(RandomIter first, RandomIter left_end, Pointer buf, Pointer buf_end, RandomIter result, Compared comp) {
+        ptrdiff_t streak_l = 0, streak_r = 0;
+        while (first != left_end && buf != buf_end) {
+            if (comp(*(buf_end - 1), *(left_end - 1))) {
+                *--result = tinystl::move(*--left_end);
+                streak_r = 0;
+                if (++streak_l >= merge_min_gallop) {
+                    const RandomIter run = tinystl::gallop_upper_bound_back(first, left_end, *(buf_end - 1), comp);
+                    result = tinystl::move_backward(run, left_end, result);
+                    left_end = run;
+                    streak_l = 0;
+                }
+            } else {
+                *--result = tinystl::move(*--buf_end);
+                streak_l = 0;
+                if (++streak_r >= merge_min_gallop) {
+                    const Pointer run = tinystl::gallop_lower_bound_back(buf, buf_end, *(left_end - 1), comp);
+                    result = tinystl::move_backward(run, buf_end, result);
+                    buf_end = run;
+                    streak_r = 0;
+                }
+            }
+        }
+        // whatever is left of the left run is already in place
+        tinystl::move_backward(buf, buf_end, result);
+    }
+
+    // merge [first, middle) and [middle, last) with a buffer of buffer_size elements,
+    // halving the larger run around a rotation whenever the smaller one does not fit
+    template <class RandomIter, class Pointer, class Distance, class Compared>
+    void merge_adaptive(RandomIter first, RandomIter middle, RandomIter last, Pointer buffer, Distance buffer_size, Compared comp) {
+        if (first == middle || middle == last) return;
+        // elements of the left run not greater than the right run's first, and elements of the right run
+        // not less than the left run's last, are already in place
+        first = tinystl::gallop_upper_bound(first, middle, *middle, comp);
+        if (first == middle) return;
+        last = tinystl::gallop_lower_bound_back(middle, last, *(middle - 1), comp);
+        const Distance len1 = middle - first;
+        const Distance len2 = last - middle;
+        if (len1 <= len2 && len1 <= buffer_size) {
+            Pointer buffer_end = tinystl::move(first, middle, buffer);
+            tinystl::merge_forward(buffer, buffer_end, middle, last, first, comp);
+        } else if (len2 <= buffer_size) {
+            Pointer buffer_end = tinystl::move(middle, last, buffer);
+            tinystl::merge_backward(first, middle, buffer, buffer_end, last, comp);
+        } else if (len1 + len2 == 2) {
+            // trimming left one element on each side, and the right one is smaller
+            tinystl::iter_swap(first, middle);
+        } else {
+            RandomIter first_cut = first;
+            RandomIter second_cut = middle;
+            if (len1 > len2) {
+                first_cut += len1 / 2;
+                second_cut = tinystl::lower_bound(middle, last, *first_cut, comp);
+            } else {
+                second_cut += len2 / 2;
+                first_cut = tinystl::upper_bound(first, middle, *second_cut, comp);
+            }
+            const RandomIter new_middle = tinystl::rotate_adaptive(first_cut, middle, second_cut,
+                static_cast<Distance>(middle - first_cut), static_cast<Distance>(second_cut - middle), buffer, buffer_size);
+            tinystl::merge_adaptive(first, first_cut, new_middle, buffer, buffer_size, comp);
+            tinystl::merge_adaptive(new_middle, second_cut, last, buffer, buffer_size, comp);
+        }
+    }
+
+    // inplace merge: uses as much temporary_buffer as it can get, down to rotations only
+    template <class RandomIter, class Compared>
+    void inplace_merge(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (first == middle || middle == last) return;
+        first = tinystl::gallop_upper_bound(first, middle, *middle, comp);
+        if (first == middle) return;
+        last = tinystl::gallop_lower_bound_back(middle, last, *(middle - 1), comp);
+        const auto len1 = middle - first;
+        const auto len2 = last - middle;
+        temporary_buffer<RandomIter, value_type> buf(first, first + (len1 < len2 ? len1 : len2));
+        tinystl::merge_adaptive(first, middle, last, buf.begin(), buf.size(), comp);
+    }
+
+    template <class RandomIter>
+    void inplace_merge(RandomIter first, RandomIter middle, RandomIter last) {
+        tinystl::inplace_merge(first, middle, last, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // loser tree over k sorted runs: node 0 holds the overall winner, nodes 1..k-1 the loser of the match played there,
+    // run i plays from leaf k + i; ties go to the lower run, which keeps the merge stable
+    template <class InputIter, class Compared>
+    class loser_tree {
+    private:
+        size_t k;
+        size_t live;
+        tinystl::unique_ptr<size_t[]> tree;
+        tinystl::unique_ptr<InputIter[]> cur;
+        tinystl::unique_ptr<InputIter[]> end;
+        Compared comp;
+
+    public:
+        template <class RangeIter>
+        loser_tree(RangeIter first, RangeIter last, Compared c)
+            : k(static_cast<size_t>(tinystl::distance(first, last))), live(0),
+              tree(new size_t[k > 0 ? k : 1]), cur(new InputIter[k > 0 ? k : 1]), end(new InputIter[k > 0 ? k : 1]), comp(c) {
+            for (size_t i = 0; first != last; ++first, ++i) {
+                cur[i] = (*first).first;
+                end[i] = (*first).second;
+                if (cur[i] != end[i]) ++live;
+            }
+            if (k == 0) return;
+            // the winner of every subtree, built bottom up
+            tinystl::unique_ptr<size_t[]> winner(new size_t[k]);
+            for (size_t node = k - 1; node >= 1; --node) {
+                const size_t l = 2 * node, r = 2 * node + 1;
+                const size_t wl = l >= k ? l - k : winner[l];
+                const size_t wr = r >= k ? r - k : winner[r];
+                if (beats(wl, wr)) { winner[node] = wl; tree[node] = wr; }
+                else { winner[node] = wr; tree[node] = wl; }
+            }
+            tree[0] = k > 1 ? winner[1] : 0;
+        }
+
+        size_t runs_left() const noexcept { return live; }
+        size_t top() const noexcept { return tree[0]; }
+        InputIter& top_iter() noexcept { return cur[tree[0]]; }
+        InputIter top_end() const noexcept { return end[tree[0]]; }
+
+        // takes the head of the winning run and plays its next element up the tree
+        void pop() {
+            size_t w = tree[0];
+            if (++cur[w] == end[w]) --live;
+            // selects instead of branches, the outcome of every match is unpredictable
+            for (size_t node = (k + w) / 2; node >= 1; node /= 2) {
+                const size_t t = tree[node];
+                const bool lost = beats(t, w);
+                tree[node] = lost ? w : t;
+                w = lost ? t : w;
+            }
+            tree[0] = w;
+        }
+
+    private:
+        bool beats(size_t a, size_t b) const {
+            if (cur[b] == end[b]) return true;
+            if (cur[a] == end[a]) return false;
+            return comp(*cur[a], *cur[b]) || (a < b && !comp(*cur[b], *cur[a]));
+        }
+    };
+
+    // multiway merge: merges the runs of a range of pair<InputIter, InputIter> into result,
+    // reading and moving every element exactly once; stable, equal elements come out in run order
+    template <class RangeIter, class OutputIter, class Compared>
+    OutputIter multiway_merge(RangeIter first, RangeIter last, OutputIter result, Compared comp) {
+        typedef typename iterator_traits<RangeIter>::value_type::first_type input_iter;
+        loser_tree<input_iter, Compared> tree(first, last, comp);
+        while (tree.runs_left() > 1) {
+            *result = tinystl::move(*tree.top_iter());
+            ++result;
+            tree.pop();
+        }
+        if (tree.runs_left() == 1) result = tinystl::move(tree.top_iter(), tree.top_end(), result);
+        return result;
+    }
+
+    template <class RangeIter, class OutputIter>
+    OutputIter multiway_merge(RangeIter first, RangeIter last, OutputIter result) {
+        typedef typename iterator_traits<RangeIter>::value_type::first_type input_iter;
+        return tinystl::multiway_merge(first, last, result, tinystl::less<typename iterator_traits<input_iter>::value_type>());
+    }
+
+    // multiway set union over runs of forward iterators: a value is written as many times as the run holding it
+    // most often holds it, which is set_union for two runs
+    template <class RangeIter, class OutputIter, class Compared>
+    OutputIter multiway_set_union(RangeIter first, RangeIter last, OutputIter result, Compared comp) {
+        typedef typename iterator_traits<RangeIter>::value_type::first_type forward_iter;
+        loser_tree<forward_iter, Compared> tree(first, last, comp);
+        // equal values arrive grouped by run: written counts the copies of the current value so far,
+        // seen its copies in the current run
+        const size_t no_run = static_cast<size_t>(-1);
+        size_t last_run = no_run, written = 0, seen = 0;
+        while (tree.runs_left() > 0) {
+            const forward_iter head = tree.top_iter();
+            const size_t run = tree.top();
+            seen = run == last_run ? seen + 1 : 1;
+            last_run = run;
+            tree.pop();
+            // the head stays in place until it is moved, so the next winner is compared against it first
+            const bool group_end = tree.runs_left() == 0 || comp(*head, *tree.top_iter());
+            if (seen > written) {
+                *result = tinystl::move(*head);
+                ++result;
+                ++written;
+            }
+            if (group_end) { last_run = no_run; written = 0; }
+        }
+        return result;
+    }
+
+    template <class RangeIter, class OutputIter>
+    OutputIter multiway_set_union(RangeIter first, RangeIter last, OutputIter result) {
+        typedef typename iterator_traits<RangeIter>::value_type::first_type input_iter;
+        return tinystl::multiway_set_union(first, last, result, tinystl::less<typename iterator_traits<input_iter>::value_type>());
+    }
+
+}
+
+#endif //TINYSTL_MERGE_H_
@@ -0,0 +1,230 @@
+#ifndef TINYSTL_MMAP_ARRAY_H_
+#define TINYSTL_MMAP_ARRAY_H_
+
+// file backed array of trivially copyable records, opened with mmap instead of read + copy
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "exceptdef.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // file header, the records start at data_offset
+    struct mmap_array_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t elem_size;
+        uint32_t elem_align;
+        uint32_t data_offset;
+        uint64_t size;
+        uint64_t capacity;
+    };
+
+    const char mmap_array_magic[8] = { 'T', 'S', 'T', 'L', 'M', 'A', 'P', '\0' };
+    const uint32_t mmap_array_version = 1;
+    const size_t mmap_array_data_offset = 64;
+
+    // class: mmap array
+    // read_only maps the file without copying; read_write creates the file if needed and grows it with ftruncate
+    template <class T>
+    class mmap_array {
+        static_assert(std::is_trivially_copyable<T>::value, "mmap_array requires a trivially copyable type");
+        static_assert(alignof(T) <= mmap_array_data_offset, "mmap_array element alignment exceeds the header size");
+
+    public:
+        typedef T               value_type;
+        typedef T*              pointer;
+        typedef const T*        const_pointer;
+        typedef T&              reference;
+        typedef const T&        const_reference;
+        typedef T*              iterator;
+        typedef const T*        const_iterator;
+        typedef size_t          size_type;
+        typedef ptrdiff_t       difference_type;
+
+        enum open_mode { read_only, read_write };
+
+    private:
+        int fd;
+        void* map;
+        size_t map_len;
+        bool writable;
+
+    public:
+        mmap_array() noexcept : fd(-1), map(nullptr), map_len(0), writable(false) {}
+        explicit mmap_array(const char* path, open_mode mode = read_only) : fd(-1), map(nullptr), map_len(0), writable(false) { open(path, mode); }
+        mmap_array(mmap_array&& rhs) noexcept : fd(rhs.fd), map(rhs.map), map_len(rhs.map_len), writable(rhs.writable) {
+            rhs.fd = -1; rhs.map = nullptr; rhs.map_len = 0; rhs.writable = false;
+        }
+        mmap_array& operator=(mmap_array&& rhs) noexcept { mmap_array tmp(tinystl::move(rhs)); swap(tmp); return *this; }
+        ~mmap_array() { close(); }
+
+    private:
+        mmap_array(const mmap_array&);
+        void operator=(const mmap_array&);
+
+    public:
+        void open(const char* path, open_mode mode = read_only);
+        void close() noexcept;
+        void flush();
+
+        bool is_open() const noexcept { return map != nullptr; }
+        bool is_writable() const noexcept { return writable; }
+
+        iterator begin() noexcept { return data(); }
+        iterator end() noexcept { return data() + size(); }
+        const_iterator begin() const noexcept { return data(); }
+        const_iterator end() const noexcept { return data() + size(); }
+
+        size_type size() const noexcept { return map ? static_cast<size_type>(header()->size) : 0; }
+        size_type capacity() const noexcept { return map ? static_cast<size_type>(header()->capacity) : 0; }
+        bool empty() const noexcept { return size() == 0; }
+
+        pointer data() noexcept { return map ? reinterpret_cast<T*>(static_cast<char*>(map) + mmap_array_data_offset) : nullptr; }
+        const_pointer data() const noexcept { return map ? reinterpret_cast<const T*>(static_cast<const char*>(map) + mmap_array_data_offset) : nullptr; }
+
+        reference operator[](size_type n) { return data()[n]; }
+        const_reference operator[](size_type n) const { return data()[n]; }
+        reference at(size_type n) { THROW_OUT_OF_RANGE_IF(n >= size(), "mmap_array<T>::at() subscript out of range"); return data()[n]; }
+        const_reference at(size_type n) const { THROW_OUT_OF_RANGE_IF(n >= size(), "mmap_array<T>::at() subscript out of range"); return data()[n]; }
+
+        void reserve(size_type n);
+        void resize(size_type n);
+        void clear() { resize(0); }
+        void push_back(const T& value) {
+            THROW_RUNTIME_ERROR_IF(!writable, "mmap_array: array is opened read only");
+            const size_type n = size();
+            if (n == capacity()) reserve(n < 16 ? 16 : n * 2);
+            data()[n] = value;
+            header()->size = n + 1;
+        }
+        void pop_back() { TINYSTL_DEBUG(writable && !empty()); --header()->size; }
+
+        void swap(mmap_array& rhs) noexcept {
+            tinystl::swap(fd, rhs.fd);
+            tinystl::swap(map, rhs.map);
+            tinystl::swap(map_len, rhs.map_len);
+            tinystl::swap(writable, rhs.writable);
+        }
+
+    private:
+        mmap_array_header* header() const noexcept { return static_cast<mmap_array_header*>(map); }
+        static size_t file_length(size_type cap) { return mmap_array_data_offset + cap * sizeof(T); }
+        // the largest capacity whose file length fits a size_t
+        static constexpr size_t max_capacity() { return (SIZE_MAX - mmap_array_data_offset) / sizeof(T); }
+        void map_file(size_t len);
+        void validate_header() const;
+        void fail(const char* what) { close(); THROW_RUNTIME_ERROR_IF(true, what); }
+    };
+
+    template <class T>
+    void mmap_array<T>::open(const char* path, open_mode mode) {
+        close();
+        writable = mode == read_write;
+        fd = ::open(path, writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+        if (fd < 0) fail("mmap_array: cannot open file");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) fail("mmap_array: cannot stat file");
+        size_t len = static_cast<size_t>(st.st_size);
+        if (len == 0 && writable) {
+            // new file: write a header for an empty array
+            mmap_array_header h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(h.magic, mmap_array_magic, sizeof(h.magic));
+            h.version = mmap_array_version;
+            h.elem_size = sizeof(T);
+            h.elem_align = alignof(T);
+            h.data_offset = mmap_array_data_offset;
+            len = file_length(0);
+            if (::ftruncate(fd, static_cast<off_t>(len)) != 0) fail("mmap_array: cannot resize file");
+            if (::pwrite(fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h))) fail("mmap_array: cannot write header");
+        }
+        if (len < mmap_array_data_offset) fail("mmap_array: file too small");
+        map_file(len);
+        validate_header();
+    }
+
+    template <class T>
+    void mmap_array<T>::close() noexcept {
+        if (map) ::munmap(map, map_len);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        map = nullptr;
+        map_len = 0;
+        writable = false;
+    }
+
+    template <class T>
+    void mmap_array<T>::flush() {
+        THROW_RUNTIME_ERROR_IF(map && writable && ::msync(map, map_len, MS_SYNC) != 0, "mmap_array: msync failed");
+    }
+
+    template <class T>
+    void mmap_array<T>::map_file(size_t len) {
+        const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* p = ::mmap(nullptr, len, prot, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) fail("mmap_array: mmap failed");
+        map = p;
+        map_len = len;
+    }
+
+    template <class T>
+    void mmap_array<T>::validate_header() const {
+        const mmap_array_header* h = header();
+        const char* what = nullptr;
+        if (std::memcmp(h->magic, mmap_array_magic, sizeof(h->magic)) != 0) what = "mmap_array: bad magic";
+        else if (h->version != mmap_array_version) what = "mmap_array: unsupported version";
+        else if (h->elem_size != sizeof(T)) what = "mmap_array: element size mismatch";
+        else if (h->elem_align != alignof(T)) what = "mmap_array: element alignment mismatch";
+        else if (h->data_offset != mmap_array_data_offset) what = "mmap_array: bad data offset";
+        else if (h->capacity > max_capacity()) what = "mmap_array: bad capacity";
+        else if (h->size > h->capacity || file_length(static_cast<size_type>(h->capacity)) > map_len) what = "mmap_array: file truncated";
+        if (what) const_cast<mmap_array*>(this)->fail(what);
+    }
+
+    template <class T>
+    void mmap_array<T>::reserve(size_type n) {
+        THROW_RUNTIME_ERROR_IF(!writable, "mmap_array: array is opened read only");
+        if (n <= capacity()) return;
+        THROW_LENGTH_ERROR_IF(n > max_capacity(), "mmap_array<T>::reserve() capacity too large");
+        const size_t len = file_length(n);
+        THROW_RUNTIME_ERROR_IF(::ftruncate(fd, static_cast<off_t>(len)) != 0, "mmap_array: cannot resize file");
+#ifdef __linux__
+        void* p = ::mremap(map, map_len, len, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) fail("mmap_array: mremap failed");
+        map = p;
+        map_len = len;
+#else
+        ::munmap(map, map_len);
+        map = nullptr;
+        map_file(len);
+#endif
+        header()->capacity = n;
+    }
+
+    template <class T>
+    void mmap_array<T>::resize(size_type n) {
+        THROW_RUNTIME_ERROR_IF(!writable, "mmap_array: array is opened read only");
+        const size_type old = size();
+        const size_type cap = capacity();
+        if (n > cap) reserve(n);
+        // ftruncate zero fills what reserve grew, only records left behind by a shrink are cleared
+        if (n > old && cap > old) std::memset(static_cast<void*>(data() + old), 0, ((n < cap ? n : cap) - old) * sizeof(T));
+        header()->size = n;
+    }
+
+    // overload swap
+    template <class T>
+    void swap(mmap_array<T>& lhs, mmap_array<T>& rhs) noexcept { lhs.swap(rhs); }
+
+}
+
+#endif //TINYSTL_MMAP_ARRAY_H_
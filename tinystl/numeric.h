@@ -0,0 +1,391 @@
+#ifndef TINYSTL_NUMERIC_H_
+#define TINYSTL_NUMERIC_H_
+
+// numeric algorithms: folds and prefix scans, with multi accumulator kernels for associative operators
+// and parallel overloads taking an execution policy
+
+#include <cstddef>
+
+#include "execution.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "type_traits.h"
+
+// floating point sums and products change in the last bits when regrouped,
+// so the multi accumulator and parallel kernels only take them when this is defined to 1
+#ifndef TINYSTL_REASSOCIATE_FLOAT
+#define TINYSTL_REASSOCIATE_FLOAT 0
+#endif
+
+namespace tinystl {
+
+    // independent accumulators of the fold kernel
+    const size_t numeric_lanes = 8;
+
+    // operators whose applications over T may be regrouped and reordered
+    template <class T>
+    struct is_reassociable_type : public bool_constant<(std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+        (std::is_floating_point<T>::value && TINYSTL_REASSOCIATE_FLOAT)> {};
+
+    template <class Op, class T> struct is_reassociable : public tinystl::false_type {};
+    template <class T> struct is_reassociable<plus<T>, T> : public is_reassociable_type<T> {};
+    template <class T> struct is_reassociable<multiplies<T>, T> : public is_reassociable_type<T> {};
+    template <class T> struct is_reassociable<minimum<T>, T> : public is_reassociable_type<T> {};
+    template <class T> struct is_reassociable<maximum<T>, T> : public is_reassociable_type<T> {};
+
+    // the default operators: plus<T> and multiplies<T> when every operand is a T, so the kernels recognise them,
+    // otherwise the plain built in operator on the operand types
+    struct numeric_add {
+        template <class T, class U>
+        auto operator()(const T& x, const U& y) const -> decltype(x + y) { return x + y; }
+    };
+    struct numeric_mul {
+        template <class T, class U>
+        auto operator()(const T& x, const U& y) const -> decltype(x * y) { return x * y; }
+    };
+    template <class T, class U, class V = T>
+    struct numeric_plus : public std::conditional<std::is_same<T, U>::value && std::is_same<T, V>::value, plus<T>, numeric_add> {};
+    template <class T, class U, class V = T>
+    struct numeric_multiplies : public std::conditional<std::is_same<T, U>::value && std::is_same<T, V>::value, multiplies<T>, numeric_mul> {};
+
+    // folds f(0) .. f(n - 1) into init over independent accumulators, which breaks the dependency chain
+    // of a serial fold and lets the compiler keep the accumulators in vector registers
+    template <class T, class BinaryOp, class Fn>
+    T numeric_fold(size_t n, T init, BinaryOp op, Fn f) {
+        T acc[numeric_lanes];
+        for (size_t k = 0; k < numeric_lanes; ++k) acc[k] = tinystl::identity_element(op);
+        size_t i = 0;
+        for (; i + numeric_lanes <= n; i += numeric_lanes) {
+            for (size_t k = 0; k < numeric_lanes; ++k) acc[k] = op(acc[k], static_cast<T>(f(i + k)));
+        }
+        for (; i < n; ++i) acc[0] = op(acc[0], static_cast<T>(f(i)));
+        for (size_t w = numeric_lanes / 2; w > 0; w /= 2) {
+            for (size_t k = 0; k < w; ++k) acc[k] = op(acc[k], acc[k + w]);
+        }
+        return op(init, acc[0]);
+    }
+
+    // the fold split into the blocks of parallel_blocks, each folded on its own; false when the range is too small
+    template <class T, class BinaryOp, class Fn>
+    bool parallel_fold(size_t n, T& init, BinaryOp op, Fn f) {
+        const size_t block = tinystl::parallel_block_size(n, sizeof(T));
+        if (block == 0) return false;
+        const size_t blocks = (n + block - 1) / block;
+        tinystl::unique_ptr<T[]> partial(new T[blocks]);
+        tinystl::parallel_for_blocks(n, block, [&](size_t lo, size_t hi) {
+            for (; lo < hi; lo += block) {
+                const size_t end = hi - lo < block ? hi : lo + block;
+                partial[lo / block] = tinystl::numeric_fold(end - lo, tinystl::identity_element(op), op, [&](size_t i) { return f(lo + i); });
+            }
+        });
+        for (size_t b = 0; b < blocks; ++b) init = op(init, partial[b]);
+        return true;
+    }
+
+    // accumulate
+    template <class InputIter, class T, class BinaryOp>
+    T accumulate_aux(InputIter first, InputIter last, T init, BinaryOp op, tinystl::false_type) {
+        for (; first != last; ++first) init = op(init, *first);
+        return init;
+    }
+    template <class RandomIter, class T, class BinaryOp>
+    T accumulate_aux(RandomIter first, RandomIter last, T init, BinaryOp op, tinystl::true_type) {
+        return tinystl::numeric_fold(static_cast<size_t>(last - first), init, op, [&](size_t i) { return *(first + i); });
+    }
+
+    template <class InputIter, class T, class BinaryOp>
+    T accumulate(InputIter first, InputIter last, T init, BinaryOp op) {
+        return tinystl::accumulate_aux(first, last, init, op,
+            bool_constant<is_random_access_iterator<InputIter>::value && is_reassociable<BinaryOp, T>::value>());
+    }
+
+    template <class InputIter, class T>
+    T accumulate(InputIter first, InputIter last, T init) {
+        return tinystl::accumulate(first, last, init, typename numeric_plus<T, typename iterator_traits<InputIter>::value_type>::type());
+    }
+
+    // reduce: regroups only the operators the kernels know to be associative
+    template <class InputIter, class T, class BinaryOp>
+    T reduce(InputIter first, InputIter last, T init, BinaryOp op) {
+        return tinystl::accumulate(first, last, init, op);
+    }
+
+    template <class InputIter, class T>
+    T reduce(InputIter first, InputIter last, T init) {
+        return tinystl::accumulate(first, last, init);
+    }
+
+    template <class InputIter>
+    typename iterator_traits<InputIter>::value_type reduce(InputIter first, InputIter last) {
+        return tinystl::accumulate(first, last, typename iterator_traits<InputIter>::value_type());
+    }
+
+    // transform reduce
+    template <class InputIter, class T, class BinaryOp, class UnaryOp>
+    T transform_reduce_aux(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op, tinystl::false_type) {
+        for (; first != last; ++first) init = reduce_op(init, transform_op(*first));
+        return init;
+    }
+    template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+    T transform_reduce_aux(RandomIter first, RandomIter last, T init, BinaryOp reduce_op, UnaryOp transform_op, tinystl::true_type) {
+        return tinystl::numeric_fold(static_cast<size_t>(last - first), init, reduce_op, [&](size_t i) { return transform_op(*(first + i)); });
+    }
+
+    template <class InputIter, class T, class BinaryOp, class UnaryOp>
+    T transform_reduce(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op) {
+        return tinystl::transform_reduce_aux(first, last, init, reduce_op, transform_op,
+            bool_constant<is_random_access_iterator<InputIter>::value && is_reassociable<BinaryOp, T>::value>());
+    }
+
+    // inner product
+    template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    T inner_product_aux(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, BinaryOp1 op1, BinaryOp2 op2, tinystl::false_type) {
+        for (; first1 != last1; ++first1, ++first2) init = op1(init, op2(*first1, *first2));
+        return init;
+    }
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+    T inner_product_aux(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init, BinaryOp1 op1, BinaryOp2 op2, tinystl::true_type) {
+        return tinystl::numeric_fold(static_cast<size_t>(last1 - first1), init, op1, [&](size_t i) { return op2(*(first1 + i), *(first2 + i)); });
+    }
+
+    template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, BinaryOp1 op1, BinaryOp2 op2) {
+        return tinystl::inner_product_aux(first1, last1, first2, init, op1, op2,
+            bool_constant<is_random_access_iterator<InputIter1>::value && is_random_access_iterator<InputIter2>::value &&
+            is_reassociable<BinaryOp1, T>::value>());
+    }
+
+    template <class InputIter1, class InputIter2, class T>
+    T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+        typedef typename iterator_traits<InputIter1>::value_type value_type1;
+        typedef typename iterator_traits<InputIter2>::value_type value_type2;
+        return tinystl::inner_product(first1, last1, first2, init,
+            typename numeric_plus<T, value_type1, value_type2>::type(), typename numeric_multiplies<T, value_type1, value_type2>::type());
+    }
+
+    template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+        return tinystl::inner_product(first1, last1, first2, init, reduce_op, transform_op);
+    }
+
+    template <class InputIter1, class InputIter2, class T>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+        return tinystl::inner_product(first1, last1, first2, init);
+    }
+
+    // inclusive scan
+    template <class InputIter, class OutputIter, class BinaryOp, class T>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp op, T init) {
+        for (; first != last; ++first, ++result) {
+            init = op(init, *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    template <class InputIter, class OutputIter, class BinaryOp>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp op) {
+        if (first == last) return result;
+        typename iterator_traits<InputIter>::value_type init = *first;
+        *result = init;
+        return tinystl::inclusive_scan(++first, last, ++result, op, init);
+    }
+
+    template <class InputIter, class OutputIter>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result) {
+        typedef typename iterator_traits<InputIter>::value_type value_type;
+        return tinystl::inclusive_scan(first, last, result, plus<value_type>());
+    }
+
+    // exclusive scan: each input is read before its output is written, so result may be first
+    template <class InputIter, class OutputIter, class T, class BinaryOp>
+    OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init, BinaryOp op) {
+        for (; first != last; ++first, ++result) {
+            T next = op(init, *first);
+            *result = init;
+            init = tinystl::move(next);
+        }
+        return result;
+    }
+
+    template <class InputIter, class OutputIter, class T>
+    OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init) {
+        return tinystl::exclusive_scan(first, last, result, init, typename numeric_plus<T, typename iterator_traits<InputIter>::value_type>::type());
+    }
+
+    // two pass parallel scan over the blocks of parallel_blocks: every block is reduced, the block sums
+    // are scanned serially, then every block is scanned again from its carry in; false when the range is too small
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+    bool parallel_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result, T init, BinaryOp op, bool inclusive) {
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t block = tinystl::parallel_block_size(n, sizeof(T));
+        if (block == 0) return false;
+        const size_t blocks = (n + block - 1) / block;
+        tinystl::unique_ptr<T[]> carry(new T[blocks + 1]);
+        tinystl::parallel_for_blocks(n, block, [&](size_t lo, size_t hi) {
+            for (; lo < hi; lo += block) {
+                const size_t end = hi - lo < block ? hi : lo + block;
+                carry[lo / block + 1] = tinystl::numeric_fold(end - lo, tinystl::identity_element(op), op, [&](size_t i) { return *(first + (lo + i)); });
+            }
+        });
+        carry[0] = init;
+        for (size_t b = 0; b < blocks; ++b) carry[b + 1] = op(carry[b], carry[b + 1]);
+        tinystl::parallel_for_blocks(n, block, [&](size_t lo, size_t hi) {
+            for (; lo < hi; lo += block) {
+                const size_t end = hi - lo < block ? hi : lo + block;
+                if (inclusive) tinystl::inclusive_scan(first + lo, first + end, result + lo, op, carry[lo / block]);
+                else tinystl::exclusive_scan(first + lo, first + end, result + lo, carry[lo / block], op);
+            }
+        });
+        return true;
+    }
+
+    // parallel overloads: only operators the kernels know to be associative are split across threads,
+    // any other operator runs the serial algorithm
+
+    // reduce
+    template <class InputIter, class T, class BinaryOp>
+    T reduce_policy(InputIter first, InputIter last, T init, BinaryOp op, tinystl::false_type) {
+        return tinystl::accumulate(first, last, init, op);
+    }
+    template <class RandomIter, class T, class BinaryOp>
+    T reduce_policy(RandomIter first, RandomIter last, T init, BinaryOp op, tinystl::true_type) {
+        if (!tinystl::parallel_fold(static_cast<size_t>(last - first), init, op, [&](size_t i) { return *(first + i); })) {
+            return tinystl::accumulate(first, last, init, op);
+        }
+        return init;
+    }
+
+    template <class ExecutionPolicy, class InputIter, class T, class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    reduce(ExecutionPolicy&&, InputIter first, InputIter last, T init, BinaryOp op) {
+        return tinystl::reduce_policy(first, last, init, op,
+            bool_constant<is_parallel_execution<ExecutionPolicy, InputIter>::value && is_reassociable<BinaryOp, T>::value>());
+    }
+    template <class ExecutionPolicy, class InputIter, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    reduce(ExecutionPolicy&& policy, InputIter first, InputIter last, T init) {
+        return tinystl::reduce(tinystl::forward<ExecutionPolicy>(policy), first, last, init,
+            typename numeric_plus<T, typename iterator_traits<InputIter>::value_type>::type());
+    }
+    template <class ExecutionPolicy, class InputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<InputIter>::value_type>::type
+    reduce(ExecutionPolicy&& policy, InputIter first, InputIter last) {
+        return tinystl::reduce(tinystl::forward<ExecutionPolicy>(policy), first, last, typename iterator_traits<InputIter>::value_type());
+    }
+
+    // transform reduce
+    template <class InputIter, class T, class BinaryOp, class UnaryOp>
+    T transform_reduce_policy(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op, tinystl::false_type) {
+        return tinystl::transform_reduce(first, last, init, reduce_op, transform_op);
+    }
+    template <class RandomIter, class T, class BinaryOp, class UnaryOp>
+    T transform_reduce_policy(RandomIter first, RandomIter last, T init, BinaryOp reduce_op, UnaryOp transform_op, tinystl::true_type) {
+        if (!tinystl::parallel_fold(static_cast<size_t>(last - first), init, reduce_op, [&](size_t i) { return transform_op(*(first + i)); })) {
+            return tinystl::transform_reduce(first, last, init, reduce_op, transform_op);
+        }
+        return init;
+    }
+
+    template <class ExecutionPolicy, class InputIter, class T, class BinaryOp, class UnaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    transform_reduce(ExecutionPolicy&&, InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op) {
+        return tinystl::transform_reduce_policy(first, last, init, reduce_op, transform_op,
+            bool_constant<is_parallel_execution<ExecutionPolicy, InputIter>::value && is_reassociable<BinaryOp, T>::value>());
+    }
+
+    template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    T transform_reduce_policy(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op, tinystl::false_type) {
+        return tinystl::inner_product(first1, last1, first2, init, reduce_op, transform_op);
+    }
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+    T transform_reduce_policy(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op, tinystl::true_type) {
+        if (!tinystl::parallel_fold(static_cast<size_t>(last1 - first1), init, reduce_op, [&](size_t i) { return transform_op(*(first1 + i), *(first2 + i)); })) {
+            return tinystl::inner_product(first1, last1, first2, init, reduce_op, transform_op);
+        }
+        return init;
+    }
+
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    transform_reduce(ExecutionPolicy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+        return tinystl::transform_reduce_policy(first1, last1, first2, init, reduce_op, transform_op,
+            bool_constant<is_parallel_execution<ExecutionPolicy, InputIter1, InputIter2>::value && is_reassociable<BinaryOp1, T>::value>());
+    }
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, T>::type
+    transform_reduce(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+        typedef typename iterator_traits<InputIter1>::value_type value_type1;
+        typedef typename iterator_traits<InputIter2>::value_type value_type2;
+        return tinystl::transform_reduce(tinystl::forward<ExecutionPolicy>(policy), first1, last1, first2, init,
+            typename numeric_plus<T, value_type1, value_type2>::type(), typename numeric_multiplies<T, value_type1, value_type2>::type());
+    }
+
+    // inclusive scan
+    template <class InputIter, class OutputIter, class BinaryOp, class T>
+    OutputIter inclusive_scan_policy(InputIter first, InputIter last, OutputIter result, BinaryOp op, T init, tinystl::false_type) {
+        return tinystl::inclusive_scan(first, last, result, op, init);
+    }
+    template <class RandomIter1, class RandomIter2, class BinaryOp, class T>
+    RandomIter2 inclusive_scan_policy(RandomIter1 first, RandomIter1 last, RandomIter2 result, BinaryOp op, T init, tinystl::true_type) {
+        if (!tinystl::parallel_scan(first, last, result, init, op, true)) return tinystl::inclusive_scan(first, last, result, op, init);
+        return result + (last - first);
+    }
+
+    template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    inclusive_scan(ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result, BinaryOp op, T init) {
+        return tinystl::inclusive_scan_policy(first, last, result, op, init,
+            bool_constant<is_parallel_execution<ExecutionPolicy, InputIter, OutputIter>::value && is_reassociable<BinaryOp, T>::value>());
+    }
+    // without an initial value the identity of a known operator stands in for it
+    template <class InputIter, class OutputIter, class BinaryOp>
+    OutputIter inclusive_scan_policy(InputIter first, InputIter last, OutputIter result, BinaryOp op, tinystl::false_type) {
+        return tinystl::inclusive_scan(first, last, result, op);
+    }
+    template <class RandomIter1, class RandomIter2, class BinaryOp>
+    RandomIter2 inclusive_scan_policy(RandomIter1 first, RandomIter1 last, RandomIter2 result, BinaryOp op, tinystl::true_type) {
+        return tinystl::inclusive_scan_policy(first, last, result, op, tinystl::identity_element(op), tinystl::true_type());
+    }
+
+    template <class ExecutionPolicy, class InputIter, class OutputIter, class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    inclusive_scan(ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result, BinaryOp op) {
+        typedef typename iterator_traits<InputIter>::value_type value_type;
+        return tinystl::inclusive_scan_policy(first, last, result, op,
+            bool_constant<is_parallel_execution<ExecutionPolicy, InputIter, OutputIter>::value && is_reassociable<BinaryOp, value_type>::value>());
+    }
+    template <class ExecutionPolicy, class InputIter, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    inclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result) {
+        return tinystl::inclusive_scan(tinystl::forward<ExecutionPolicy>(policy), first, last, result, plus<typename iterator_traits<InputIter>::value_type>());
+    }
+
+    // exclusive scan
+    template <class InputIter, class OutputIter, class T, class BinaryOp>
+    OutputIter exclusive_scan_policy(InputIter first, InputIter last, OutputIter result, T init, BinaryOp op, tinystl::false_type) {
+        return tinystl::exclusive_scan(first, last, result, init, op);
+    }
+    template <class RandomIter1, class RandomIter2, class T, class BinaryOp>
+    RandomIter2 exclusive_scan_policy(RandomIter1 first, RandomIter1 last, RandomIter2 result, T init, BinaryOp op, tinystl::true_type) {
+        if (!tinystl::parallel_scan(first, last, result, init, op, false)) return tinystl::exclusive_scan(first, last, result, init, op);
+        return result + (last - first);
+    }
+
+    template <class ExecutionPolicy, class InputIter, class OutputIter, class T, class BinaryOp>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    exclusive_scan(ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result, T init, BinaryOp op) {
+        return tinystl::exclusive_scan_policy(first, last, result, init, op,
+            bool_constant<is_parallel_execution<ExecutionPolicy, InputIter, OutputIter>::value && is_reassociable<BinaryOp, T>::value>());
+    }
+    template <class ExecutionPolicy, class InputIter, class OutputIter, class T>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    exclusive_scan(ExecutionPolicy&& policy, InputIter first, InputIter last, OutputIter result, T init) {
+        return tinystl::exclusive_scan(tinystl::forward<ExecutionPolicy>(policy), first, last, result, init,
+            typename numeric_plus<T, typename iterator_traits<InputIter>::value_type>::type());
+    }
+
+}
+
+#endif //TINYSTL_NUMERIC_H_
@@ -0,0 +1,172 @@
+#ifndef TINYSTL_PARALLEL_SET_ALGO_H_
+#define TINYSTL_PARALLEL_SET_ALGO_H_
+
+// overloads of the set algorithms taking an execution policy, apart from set_algo.h
+// so the serial algorithms do not pull in the thread pool
+
+#include <cstddef>
+
+#include "execution.h"
+#include "functional.h"
+#include "iterator.h"
+#include "memory.h"
+#include "merge.h"
+#include "set_algo.h"
+
+namespace tinystl {
+
+    // both inputs are cut into pieces of equal merge path length; a piece starting at co-ranks (i, j)
+    // cannot have written more than bound(i, j) elements before it, so every piece writes once at that
+    // bound in a scratch buffer and the pieces are then moved together into the result
+
+    // merge path co-rank: how many of the first d merged elements come from the first range, ties first
+    template <class RandomIter1, class RandomIter2, class Compared>
+    ptrdiff_t merge_path_corank(RandomIter1 first1, ptrdiff_t n1, RandomIter2 first2, ptrdiff_t n2, ptrdiff_t d, Compared comp) {
+        ptrdiff_t lo = d > n2 ? d - n2 : 0, hi = d < n1 ? d : n1;
+        while (lo < hi) {
+            const ptrdiff_t i = lo + (hi - lo) / 2;
+            if (!comp(*(first2 + (d - i - 1)), *(first1 + i))) lo = i + 1;
+            else hi = i;
+        }
+        return lo;
+    }
+
+    // moves a split back to the first element equal to the key, so equal runs never straddle two pieces
+    template <class RandomIter1, class RandomIter2, class T, class Compared>
+    void set_split_snap(RandomIter1 first1, ptrdiff_t& i, RandomIter2 first2, ptrdiff_t& j, const T& key, Compared comp) {
+        i = tinystl::gallop_lower_bound_back(first1, first1 + i, key, comp) - first1;
+        j = tinystl::gallop_lower_bound_back(first2, first2 + j, key, comp) - first2;
+    }
+
+    template <class RandomIter1, class RandomIter2, class Compared>
+    void set_split(RandomIter1 first1, ptrdiff_t n1, RandomIter2 first2, ptrdiff_t n2, ptrdiff_t d, ptrdiff_t& i, ptrdiff_t& j, Compared comp) {
+        i = tinystl::merge_path_corank(first1, n1, first2, n2, d, comp);
+        j = d - i;
+        if (i < n1 && (j == n2 || !comp(*(first2 + j), *(first1 + i)))) tinystl::set_split_snap(first1, i, first2, j, *(first1 + i), comp);
+        else if (j < n2) tinystl::set_split_snap(first1, i, first2, j, *(first2 + j), comp);
+    }
+
+    struct set_union_op {
+        static ptrdiff_t bound(ptrdiff_t i, ptrdiff_t j) { return i + j; }
+        template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+        OutputIter operator()(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) const {
+            return tinystl::set_union(first1, last1, first2, last2, result, comp);
+        }
+    };
+    struct set_intersection_op {
+        static ptrdiff_t bound(ptrdiff_t i, ptrdiff_t) { return i; }
+        template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+        OutputIter operator()(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) const {
+            return tinystl::set_intersection(first1, last1, first2, last2, result, comp);
+        }
+    };
+    struct set_difference_op {
+        static ptrdiff_t bound(ptrdiff_t i, ptrdiff_t) { return i; }
+        template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+        OutputIter operator()(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) const {
+            return tinystl::set_difference(first1, last1, first2, last2, result, comp);
+        }
+    };
+    struct set_symmetric_difference_op {
+        static ptrdiff_t bound(ptrdiff_t i, ptrdiff_t j) { return i + j; }
+        template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+        OutputIter operator()(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) const {
+            return tinystl::set_symmetric_difference(first1, last1, first2, last2, result, comp);
+        }
+    };
+
+    template <class InputIter1, class InputIter2, class OutputIter, class Compared, class SetOp>
+    OutputIter set_policy(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp, SetOp op, tinystl::false_type) {
+        return op(first1, last1, first2, last2, result, comp);
+    }
+
+    template <class RandomIter1, class RandomIter2, class RandomIter3, class Compared, class SetOp>
+    RandomIter3 set_policy(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2, RandomIter3 result, Compared comp, SetOp op, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        const ptrdiff_t n1 = last1 - first1, n2 = last2 - first2, n = n1 + n2;
+        thread_pool& pool = tinystl::default_thread_pool();
+        const size_t bytes = static_cast<size_t>(n) * sizeof(value_type);
+        if (pool.size() < 2 || bytes < parallel_threshold()) return op(first1, last1, first2, last2, result, comp);
+
+        // a few pieces per thread, each at least a block long
+        ptrdiff_t pieces = static_cast<ptrdiff_t>(pool.size()) * 8;
+        if (pieces > static_cast<ptrdiff_t>(bytes / parallel_block_bytes)) pieces = static_cast<ptrdiff_t>(bytes / parallel_block_bytes);
+        if (pieces < 2) return op(first1, last1, first2, last2, result, comp);
+
+        tinystl::unique_ptr<ptrdiff_t[]> split1(new ptrdiff_t[pieces + 1]);
+        tinystl::unique_ptr<ptrdiff_t[]> split2(new ptrdiff_t[pieces + 1]);
+        tinystl::unique_ptr<size_t[]> offset(new size_t[pieces + 1]);
+        split1[0] = split2[0] = 0;
+        split1[pieces] = n1; split2[pieces] = n2;
+        pool.parallel_for(static_cast<ptrdiff_t>(1), pieces, [&](ptrdiff_t b, ptrdiff_t e) {
+            for (ptrdiff_t k = b; k < e; ++k) tinystl::set_split(first1, n1, first2, n2, n / pieces * k + n % pieces * k / pieces, split1[k], split2[k], comp);
+        }, 1);
+
+        // every piece writes at its bound, then moves its output behind the pieces before it
+        typedef typename iterator_traits<RandomIter3>::value_type out_type;
+        scratch_buffer<out_type> buf(SetOp::bound(n1, n2), n1 > 0 ? *first1 : *first2);
+        out_type* const scratch = buf.begin();
+        offset[0] = 0;
+        pool.parallel_for(static_cast<ptrdiff_t>(0), pieces, [&](ptrdiff_t b, ptrdiff_t e) {
+            for (ptrdiff_t k = b; k < e; ++k) {
+                out_type* const out = scratch + SetOp::bound(split1[k], split2[k]);
+                offset[k + 1] = static_cast<size_t>(op(first1 + split1[k], first1 + split1[k + 1], first2 + split2[k], first2 + split2[k + 1], out, comp) - out);
+            }
+        }, 1);
+        for (ptrdiff_t k = 0; k < pieces; ++k) offset[k + 1] += offset[k];
+        const size_t total = offset[pieces] * sizeof(out_type);
+        pool.parallel_for(static_cast<ptrdiff_t>(0), pieces, [&](ptrdiff_t b, ptrdiff_t e) {
+            for (ptrdiff_t k = b; k < e; ++k) {
+                out_type* const out = scratch + SetOp::bound(split1[k], split2[k]);
+                tinystl::parallel_move_block(out, out + (offset[k + 1] - offset[k]), result + offset[k], total);
+            }
+        }, 1);
+        return result + offset[pieces];
+    }
+
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter, class Compared>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_union(ExecutionPolicy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+        return tinystl::set_policy(first1, last1, first2, last2, result, comp, set_union_op(), is_parallel_execution<ExecutionPolicy, InputIter1, InputIter2, OutputIter>());
+    }
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_union(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+        return tinystl::set_union(tinystl::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, tinystl::less<typename iterator_traits<InputIter1>::value_type>());
+    }
+
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter, class Compared>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_intersection(ExecutionPolicy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+        return tinystl::set_policy(first1, last1, first2, last2, result, comp, set_intersection_op(), is_parallel_execution<ExecutionPolicy, InputIter1, InputIter2, OutputIter>());
+    }
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_intersection(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+        return tinystl::set_intersection(tinystl::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, tinystl::less<typename iterator_traits<InputIter1>::value_type>());
+    }
+
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter, class Compared>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_difference(ExecutionPolicy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+        return tinystl::set_policy(first1, last1, first2, last2, result, comp, set_difference_op(), is_parallel_execution<ExecutionPolicy, InputIter1, InputIter2, OutputIter>());
+    }
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_difference(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+        return tinystl::set_difference(tinystl::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, tinystl::less<typename iterator_traits<InputIter1>::value_type>());
+    }
+
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter, class Compared>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_symmetric_difference(ExecutionPolicy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
+        return tinystl::set_policy(first1, last1, first2, last2, result, comp, set_symmetric_difference_op(), is_parallel_execution<ExecutionPolicy, InputIter1, InputIter2, OutputIter>());
+    }
+    template <class ExecutionPolicy, class InputIter1, class InputIter2, class OutputIter>
+    typename enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+    set_symmetric_difference(ExecutionPolicy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
+        return tinystl::set_symmetric_difference(tinystl::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, tinystl::less<typename iterator_traits<InputIter1>::value_type>());
+    }
+}
+
+#endif //TINYSTL_PARALLEL_SET_ALGO_H_
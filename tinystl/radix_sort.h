@@ -0,0 +1,164 @@
+#ifndef TINYSTL_RADIX_SORT_H_
+#define TINYSTL_RADIX_SORT_H_
+
+// least significant digit radix sort on byte digits for integer, floating point and pair keys
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "memory.h"
+#include "sort.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // ranges below this size are insertion sorted
+    const ptrdiff_t radix_sort_threshold = 64;
+
+    // radix traits: a key as a sequence of byte digits, digit 0 least significant,
+    // ordered so that unsigned digit order is the key order
+    template <class T, class = void>
+    struct radix_traits;
+
+    template <class T>
+    struct radix_traits<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+        typedef typename std::make_unsigned<T>::type bits_type;
+        static const unsigned bytes = sizeof(T);
+
+        // signed keys flip the sign bit so negatives order below positives
+        static bits_type to_bits(T x) noexcept {
+            const bits_type sign = std::is_signed<T>::value ? static_cast<bits_type>(bits_type(1) << (sizeof(T) * 8 - 1)) : 0;
+            return static_cast<bits_type>(static_cast<bits_type>(x) ^ sign);
+        }
+        static unsigned digit(T x, unsigned b) noexcept { return static_cast<unsigned>(to_bits(x) >> (b * 8)) & 0xff; }
+        static bool less(T x, T y) noexcept { return x < y; }
+    };
+
+    // bool has no unsigned counterpart: a single digit, false before true
+    template <>
+    struct radix_traits<bool, void> {
+        static const unsigned bytes = 1;
+
+        static unsigned digit(bool x, unsigned) noexcept { return x ? 1u : 0u; }
+        static bool less(bool x, bool y) noexcept { return !x && y; }
+    };
+
+    template <class T>
+    struct radix_traits<T, typename std::enable_if<std::is_same<T, float>::value || std::is_same<T, double>::value>::type> {
+        typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type bits_type;
+        static const unsigned bytes = sizeof(T);
+
+        // negatives flip every bit so larger magnitudes order lower, positives flip only the sign bit
+        static bits_type to_bits(T x) noexcept {
+            bits_type bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            const bits_type sign = bits_type(1) << (sizeof(T) * 8 - 1);
+            const bits_type mask = static_cast<bits_type>(-static_cast<bits_type>(bits >> (sizeof(T) * 8 - 1))) | sign;
+            return bits ^ mask;
+        }
+        static unsigned digit(T x, unsigned b) noexcept { return static_cast<unsigned>(to_bits(x) >> (b * 8)) & 0xff; }
+        static bool less(T x, T y) noexcept { return to_bits(x) < to_bits(y); }
+    };
+
+    // pairs sort by first, then second: the digits of second come first
+    template <class T1, class T2>
+    struct radix_traits<tinystl::pair<T1, T2>, void> {
+        typedef radix_traits<T1> first_traits;
+        typedef radix_traits<T2> second_traits;
+        static const unsigned bytes = first_traits::bytes + second_traits::bytes;
+
+        static unsigned digit(const tinystl::pair<T1, T2>& x, unsigned b) noexcept {
+            return b < second_traits::bytes ? second_traits::digit(x.second, b) : first_traits::digit(x.first, b - second_traits::bytes);
+        }
+        static bool less(const tinystl::pair<T1, T2>& x, const tinystl::pair<T1, T2>& y) noexcept {
+            return first_traits::less(x.first, y.first) || (!first_traits::less(y.first, x.first) && second_traits::less(x.second, y.second));
+        }
+    };
+
+    template <class T>
+    struct radix_identity {
+        const T& operator()(const T& x) const noexcept { return x; }
+    };
+
+    // orders values by their extracted keys, used for the small range and out of memory paths
+    template <class KeyFn, class Key>
+    struct radix_key_less {
+        KeyFn key;
+        explicit radix_key_less(KeyFn k) : key(k) {}
+        template <class T>
+        bool operator()(const T& x, const T& y) const { return radix_traits<Key>::less(key(x), key(y)); }
+    };
+
+    // one scatter pass by digit b, offsets hold the running start of every bucket
+    template <class InputIter, class OutputIter, class KeyFn, class Key>
+    void radix_scatter(InputIter first, InputIter last, OutputIter result, KeyFn key, unsigned b, size_t* offsets, Key*) {
+        for (; first != last; ++first) {
+            const unsigned d = radix_traits<Key>::digit(key(*first), b);
+            *(result + offsets[d]++) = tinystl::move(*first);
+        }
+    }
+
+    // the scatter passes, alternating between the range and the scratch buffer
+    template <class RandomIter, class KeyFn, class Key, size_t Bytes>
+    void radix_sort_passes(RandomIter first, RandomIter last, KeyFn key, typename iterator_traits<RandomIter>::value_type* scratch,
+                           size_t (&counts)[Bytes][256], const unsigned* passes, unsigned pass_count, Key*) {
+        const ptrdiff_t n = last - first;
+        for (unsigned p = 0; p < pass_count; ++p) {
+            size_t* const count = counts[passes[p]];
+            size_t sum = 0;
+            for (unsigned d = 0; d < 256; ++d) { const size_t c = count[d]; count[d] = sum; sum += c; }
+            if (p % 2 == 0) tinystl::radix_scatter(first, last, scratch, key, passes[p], count, static_cast<Key*>(0));
+            else tinystl::radix_scatter(scratch, scratch + n, first, key, passes[p], count, static_cast<Key*>(0));
+        }
+        if (pass_count % 2 == 1) tinystl::move(scratch, scratch + n, first);
+    }
+
+    // radix sort, always stable: when the temporary buffer comes up short the full scratch
+    // is allocated instead of handing the range to an unstable sort
+    template <class RandomIter, class KeyFn>
+    void radix_sort(RandomIter first, RandomIter last, KeyFn key) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        typedef radix_traits<key_type> traits;
+        const ptrdiff_t n = last - first;
+        if (n < 2) return;
+        const radix_key_less<KeyFn, key_type> comp(key);
+        if (n < radix_sort_threshold) { tinystl::insertion_sort(first, last, comp); return; }
+
+        // every digit histogram in a single read of the input
+        size_t counts[traits::bytes][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (RandomIter cur = first; cur != last; ++cur) {
+            const key_type& k = key(*cur);
+            for (unsigned b = 0; b < traits::bytes; ++b) ++counts[b][traits::digit(k, b)];
+        }
+        // a digit shared by every key leaves the order unchanged
+        unsigned passes[traits::bytes];
+        unsigned pass_count = 0;
+        const key_type& k0 = key(*first);
+        for (unsigned b = 0; b < traits::bytes; ++b) {
+            if (counts[b][traits::digit(k0, b)] != static_cast<size_t>(n)) passes[pass_count++] = b;
+        }
+        if (pass_count == 0) return;
+
+        {
+            temporary_buffer<RandomIter, value_type> buf(first, last);
+            if (buf.size() == n) {
+                tinystl::radix_sort_passes(first, last, key, buf.begin(), counts, passes, pass_count, static_cast<key_type*>(0));
+                return;
+            }
+        }
+        scratch_buffer<value_type> buf(n, *first);
+        tinystl::radix_sort_passes(first, last, key, buf.begin(), counts, passes, pass_count, static_cast<key_type*>(0));
+    }
+
+    template <class RandomIter>
+    void radix_sort(RandomIter first, RandomIter last) {
+        tinystl::radix_sort(first, last, radix_identity<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+}
+
+#endif //TINYSTL_RADIX_SORT_H_
@@ -2,7 +2,10 @@
 #define TINYSTL_SET_ALGO_H_
 
 #include "algobase.h"
+#include "functional.h"
 #include "iterator.h"
+#include "merge.h"
+#include "simd.h"
 
 namespace tinystl {
 
@@ -51,6 +54,48 @@ namespace tinystl {
         return result;
     }
 
+    // sorted integer arrays: when one side is much shorter, each of its elements gallops through the other,
+    // otherwise both sides are compared a vector block at a time
+    const size_t set_gallop_ratio = 32;
+
+    template <class Tp, class Up, class Vp>
+    struct is_simd_intersectable : public bool_constant<std::is_integral<Vp>::value && !std::is_same<Vp, bool>::value &&
+        (sizeof(Vp) == 4 || sizeof(Vp) == 8) && std::is_same<typename std::remove_const<Tp>::type, Vp>::value &&
+        std::is_same<typename std::remove_const<Up>::type, Vp>::value> {};
+
+    // takes the matches of the shorter range from the longer one, the output comes from the first range
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    OutputIter set_intersection_gallop(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2, OutputIter result, Compared comp) {
+        if (last1 - first1 <= last2 - first2) {
+            for (; first1 != last1 && first2 != last2; ++first1) {
+                first2 = tinystl::gallop_lower_bound(first2, last2, *first1, comp);
+                if (first2 != last2 && !comp(*first1, *first2)) { *result = *first1; ++result; ++first2; }
+            }
+        } else {
+            for (; first2 != last2 && first1 != last1; ++first2) {
+                first1 = tinystl::gallop_lower_bound(first1, last1, *first2, comp);
+                if (first1 != last1 && !comp(*first2, *first1)) { *result = *first1; ++result; ++first1; }
+            }
+        }
+        return result;
+    }
+
+    template <class Tp, class Up, class Vp>
+    typename std::enable_if<is_simd_intersectable<Tp, Up, Vp>::value, Vp*>::type
+    set_intersection(Tp* first1, Tp* last1, Up* first2, Up* last2, Vp* result) {
+        const size_t n1 = static_cast<size_t>(last1 - first1), n2 = static_cast<size_t>(last2 - first2);
+        if (n1 > n2 * set_gallop_ratio || n2 > n1 * set_gallop_ratio) {
+            return tinystl::set_intersection_gallop(first1, last1, first2, last2, result, tinystl::less<Vp>());
+        }
+        return result + tinystl::simd_intersect<Vp>(first1, n1, first2, n2, result);
+    }
+
+    template <class Tp, class Up, class Vp>
+    typename std::enable_if<is_simd_intersectable<Tp, Up, Vp>::value, Vp*>::type
+    set_intersection(Tp* first1, Tp* last1, Up* first2, Up* last2, Vp* result, tinystl::less<Vp>) {
+        return tinystl::set_intersection(first1, last1, first2, last2, result);
+    }
+
     // difference
     template <class InputIter1, class InputIter2, class OutputIter>
     OutputIter set_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result) {
@@ -66,7 +111,7 @@ namespace tinystl {
     OutputIter set_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
         while (first1 != last1 && first2 != last2) {
             if (comp(*first1, *first2)) { *result = *first1; ++first1; ++result; }
-            else if (comp(*first2 < *first1)) { ++first2; }
+            else if (comp(*first2, *first1)) { ++first2; }
             else { ++first1; ++first2; }
         }
         return tinystl::copy(first1, last1, result);
@@ -86,8 +131,8 @@ namespace tinystl {
     template <class InputIter1, class InputIter2, class OutputIter, class Compared>
     OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2, OutputIter result, Compared comp) {
         while (first1 != last1 && first2 != last2) {
-            if (comp(*first1 < *first2)) { *result = *first1; ++first1; ++result; }
-            else if (comp(*first2 < *first1)) { *result = *first2; ++first2; ++result; }
+            if (comp(*first1, *first2)) { *result = *first1; ++first1; ++result; }
+            else if (comp(*first2, *first1)) { *result = *first2; ++first2; ++result; }
             else { ++first1; ++first2; }
         }
         return tinystl::copy(first2, last2, tinystl::copy(first1, last1, result));
@@ -0,0 +1,735 @@
+#ifndef TINYSTL_SIMD_H_
+#define TINYSTL_SIMD_H_
+
+// x86 vector kernels behind runtime cpu dispatch, with portable scalar fallbacks
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TINYSTL_SIMD_X86 1
+#include <immintrin.h>
+#define TINYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#define TINYSTL_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define TINYSTL_SIMD_X86 0
+#endif
+
+namespace tinystl {
+
+    // cpu features, detected once
+    inline bool cpu_has_avx2() noexcept {
+#if TINYSTL_SIMD_X86
+        static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+        return has;
+#else
+        return false;
+#endif
+    }
+
+    inline bool cpu_has_avx512() noexcept {
+#if TINYSTL_SIMD_X86
+        static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("avx512f") != 0);
+        return has;
+#else
+        return false;
+#endif
+    }
+
+    // mismatch: byte offset of the first difference of a and b, n if they are equal
+    inline size_t simd_mismatch_scalar(const unsigned char* a, const unsigned char* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            uint64_t x, y;
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            if (x != y) break;
+        }
+        for (; i < n; ++i) { if (a[i] != b[i]) return i; }
+        return n;
+    }
+
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+    inline size_t simd_mismatch_sse2(const unsigned char* a, const unsigned char* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            const unsigned diff = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xffffu;
+            if (diff) return i + static_cast<size_t>(__builtin_ctz(diff));
+        }
+        return i + simd_mismatch_scalar(a + i, b + i, n - i);
+    }
+#endif
+
+#if TINYSTL_SIMD_X86
+    TINYSTL_TARGET_AVX2
+    inline size_t simd_mismatch_avx2(const unsigned char* a, const unsigned char* b, size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32));
+            const __m256i y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32));
+            const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(x0, y0), _mm256_cmpeq_epi8(x1, y1));
+            if (static_cast<unsigned>(_mm256_movemask_epi8(eq)) != 0xffffffffu) break;
+        }
+        for (; i + 32 <= n; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            const unsigned diff = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+            if (diff) return i + static_cast<size_t>(__builtin_ctz(diff));
+        }
+        return i + simd_mismatch_scalar(a + i, b + i, n - i);
+    }
+#endif
+
+    inline size_t simd_mismatch(const void* a, const void* b, size_t n) noexcept {
+        const unsigned char* x = static_cast<const unsigned char*>(a);
+        const unsigned char* y = static_cast<const unsigned char*>(b);
+#if TINYSTL_SIMD_X86
+        if (n >= 32 && cpu_has_avx2()) return simd_mismatch_avx2(x, y, n);
+#endif
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+        return simd_mismatch_sse2(x, y, n);
+#else
+        return simd_mismatch_scalar(x, y, n);
+#endif
+    }
+
+    // intersection of two sorted arrays of 4 or 8 byte integers into out, returns the number written;
+    // blocks holding equal neighbours are merged one element at a time, which keeps the multiset semantics
+    template <class T>
+    inline size_t simd_intersect_merge(const T* a, size_t& i, size_t na, const T* b, size_t& j, size_t nb, T* out, size_t o) noexcept {
+        while (i < na && j < nb) {
+            if (a[i] < b[j]) ++i;
+            else if (b[j] < a[i]) ++j;
+            else { out[o++] = a[i]; ++i; ++j; }
+        }
+        return o;
+    }
+
+    // after a block compare every element up to the smaller of the two block maxima is done with
+    template <size_t W, class T>
+    inline void simd_intersect_advance(const T* a, size_t& i, const T* b, size_t& j) noexcept {
+        const T amax = a[i + W - 1], bmax = b[j + W - 1];
+        size_t ka = 0, kb = 0;
+        for (size_t k = 0; k < W; ++k) { ka += !(bmax < a[i + k]); kb += !(amax < b[j + k]); }
+        i += ka;
+        j += kb;
+    }
+
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+    template <class T>
+    inline size_t simd_intersect32_sse2(const T* a, size_t na, const T* b, size_t nb, T* out) noexcept {
+        size_t i = 0, j = 0, o = 0;
+        while (i + 4 <= na && j + 4 <= nb) {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+            const int dup = _mm_movemask_ps(_mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(va, _mm_srli_si128(va, 4)), _mm_cmpeq_epi32(vb, _mm_srli_si128(vb, 4))))) & 0x7;
+            if (dup) { o = simd_intersect_merge(a, i, i + 4, b, j, j + 4, out, o); continue; }
+            // every rotation of b against a
+            __m128i eq = _mm_cmpeq_epi32(va, vb);
+            vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)); eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+            vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)); eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+            vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)); eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, vb));
+            const T* const block = a + i;
+            simd_intersect_advance<4>(a, i, b, j);
+            for (unsigned m = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq))); m; m &= m - 1) out[o++] = block[__builtin_ctz(m)];
+        }
+        return simd_intersect_merge(a, i, na, b, j, nb, out, o);
+    }
+
+    // sse2 has no 64 bit compare, both halves have to match
+    inline __m128i simd_cmpeq64_sse2(__m128i x, __m128i y) noexcept {
+        const __m128i eq = _mm_cmpeq_epi32(x, y);
+        return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    template <class T>
+    inline size_t simd_intersect64_sse2(const T* a, size_t na, const T* b, size_t nb, T* out) noexcept {
+        size_t i = 0, j = 0, o = 0;
+        while (i + 2 <= na && j + 2 <= nb) {
+            if (a[i] == a[i + 1] || b[j] == b[j + 1]) { o = simd_intersect_merge(a, i, i + 2, b, j, j + 2, out, o); continue; }
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+            const __m128i eq = _mm_or_si128(simd_cmpeq64_sse2(va, vb), simd_cmpeq64_sse2(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+            const T* const block = a + i;
+            simd_intersect_advance<2>(a, i, b, j);
+            for (unsigned m = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(eq))); m; m &= m - 1) out[o++] = block[__builtin_ctz(m)];
+        }
+        return simd_intersect_merge(a, i, na, b, j, nb, out, o);
+    }
+#endif
+
+#if TINYSTL_SIMD_X86
+    template <class T>
+    TINYSTL_TARGET_AVX2
+    inline size_t simd_intersect32_avx2(const T* a, size_t na, const T* b, size_t nb, T* out) noexcept {
+        const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+        const __m256i next = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 7);
+        size_t i = 0, j = 0, o = 0;
+        while (i + 8 <= na && j + 8 <= nb) {
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+            const __m256i dups = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(va, next)),
+                                                 _mm256_cmpeq_epi32(vb, _mm256_permutevar8x32_epi32(vb, next)));
+            if ((_mm256_movemask_ps(_mm256_castsi256_ps(dups)) & 0x7f)) {
+                o = simd_intersect_merge(a, i, i + 8, b, j, j + 8, out, o);
+                continue;
+            }
+            __m256i eq = _mm256_cmpeq_epi32(va, vb);
+            for (int r = 1; r < 8; ++r) {
+                vb = _mm256_permutevar8x32_epi32(vb, rotate);
+                eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+            }
+            const T* const block = a + i;
+            simd_intersect_advance<8>(a, i, b, j);
+            for (unsigned m = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq))); m; m &= m - 1) out[o++] = block[__builtin_ctz(m)];
+        }
+        return simd_intersect_merge(a, i, na, b, j, nb, out, o);
+    }
+
+    template <class T>
+    TINYSTL_TARGET_AVX2
+    inline size_t simd_intersect64_avx2(const T* a, size_t na, const T* b, size_t nb, T* out) noexcept {
+        size_t i = 0, j = 0, o = 0;
+        while (i + 4 <= na && j + 4 <= nb) {
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+            const __m256i dups = _mm256_or_si256(_mm256_cmpeq_epi64(va, _mm256_permute4x64_epi64(va, _MM_SHUFFLE(3, 3, 2, 1))),
+                                                 _mm256_cmpeq_epi64(vb, _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(3, 3, 2, 1))));
+            if ((_mm256_movemask_pd(_mm256_castsi256_pd(dups)) & 0x7)) {
+                o = simd_intersect_merge(a, i, i + 4, b, j, j + 4, out, o);
+                continue;
+            }
+            __m256i eq = _mm256_cmpeq_epi64(va, vb);
+            vb = _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1)); eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+            vb = _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1)); eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+            vb = _mm256_permute4x64_epi64(vb, _MM_SHUFFLE(0, 3, 2, 1)); eq = _mm256_or_si256(eq, _mm256_cmpeq_epi64(va, vb));
+            const T* const block = a + i;
+            simd_intersect_advance<4>(a, i, b, j);
+            for (unsigned m = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq))); m; m &= m - 1) out[o++] = block[__builtin_ctz(m)];
+        }
+        return simd_intersect_merge(a, i, na, b, j, nb, out, o);
+    }
+#endif
+
+    template <class T>
+    inline size_t simd_intersect(const T* a, size_t na, const T* b, size_t nb, T* out) noexcept {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "simd_intersect needs 4 or 8 byte integers");
+#if TINYSTL_SIMD_X86
+        if (cpu_has_avx2()) return sizeof(T) == 4 ? simd_intersect32_avx2(a, na, b, nb, out) : simd_intersect64_avx2(a, na, b, nb, out);
+#endif
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+        return sizeof(T) == 4 ? simd_intersect32_sse2(a, na, b, nb, out) : simd_intersect64_sse2(a, na, b, nb, out);
+#else
+        size_t i = 0, j = 0;
+        return simd_intersect_merge(a, i, na, b, j, nb, out, 0);
+#endif
+    }
+
+    // stores larger than the last level cache bypass it, so a huge fill or copy does not evict the working set;
+    // define TINYSTL_STREAMING_THRESHOLD (bytes) to override the detected size
+    inline size_t simd_detect_llc_size() noexcept {
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+        const long llc = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if (llc > 0) return static_cast<size_t>(llc);
+#endif
+        return static_cast<size_t>(32) << 20;
+    }
+
+    inline size_t simd_streaming_threshold() noexcept {
+#ifdef TINYSTL_STREAMING_THRESHOLD
+        return static_cast<size_t>(TINYSTL_STREAMING_THRESHOLD);
+#else
+        static const size_t threshold = simd_detect_llc_size();
+        return threshold;
+#endif
+    }
+
+    // fill: buf holds the pattern repeated over 64 bytes, every 16 byte aligned offset of the output starts on a pattern boundary
+    inline void simd_fill_scalar(unsigned char* d, const unsigned char* buf, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) std::memcpy(d + i, buf, 32);
+        std::memcpy(d + i, buf, bytes - i);
+    }
+
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+    inline void simd_fill_sse2(unsigned char* d, const unsigned char* buf, size_t bytes) noexcept {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+        size_t i = 0;
+        for (; i + 64 <= bytes; i += 64) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), v);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i + 16), v);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i + 32), v);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i + 48), v);
+        }
+        for (; i + 16 <= bytes; i += 16) _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), v);
+        std::memcpy(d + i, buf, bytes - i);
+    }
+
+    // non temporal stores need 16 byte alignment: fill the head normally, then shift the pattern by the head length
+    inline void simd_fill_stream(unsigned char* d, const unsigned char* buf, size_t size, size_t bytes) noexcept {
+        size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+        if (head > bytes) head = bytes;
+        std::memcpy(d, buf, head);
+        const unsigned char* rot = buf + head % size;
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rot));
+        size_t i = head;
+        for (; i + 64 <= bytes; i += 64) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), v);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 16), v);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 32), v);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 48), v);
+        }
+        for (; i + 16 <= bytes; i += 16) _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), v);
+        _mm_sfence();
+        std::memcpy(d + i, rot, bytes - i);
+    }
+#endif
+
+#if TINYSTL_SIMD_X86
+    TINYSTL_TARGET_AVX2
+    inline void simd_fill_avx2(unsigned char* d, const unsigned char* buf, size_t bytes) noexcept {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf));
+        size_t i = 0;
+        for (; i + 128 <= bytes; i += 128) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 32), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 64), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 96), v);
+        }
+        for (; i + 32 <= bytes; i += 32) _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), v);
+        std::memcpy(d + i, buf, bytes - i);
+    }
+#endif
+
+    // write count copies of a size byte pattern, false when the pattern can't be vectorised
+    // (non zero and size not a power of two up to 16). total is the byte size of the whole fill
+    // this call is a slice of, it decides whether to stream
+    inline bool simd_fill(void* dst, const void* pattern, size_t size, size_t count, size_t total) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(pattern);
+        unsigned char* d = static_cast<unsigned char*>(dst);
+        const size_t bytes = size * count;
+        bool zero = true;
+        for (size_t i = 0; i < size; ++i) zero &= p[i] == 0;
+        if (zero) size = 1;
+        else if (size > 16 || (size & (size - 1)) != 0) return false;
+        if (bytes == 0) return true;
+        unsigned char buf[64];
+        for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = p[i % size];
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+        if (total >= simd_streaming_threshold()) { simd_fill_stream(d, buf, size, bytes); return true; }
+#endif
+        if (size == 1) { std::memset(d, buf[0], bytes); return true; }
+#if TINYSTL_SIMD_X86
+        if (bytes >= 128 && cpu_has_avx2()) { simd_fill_avx2(d, buf, bytes); return true; }
+#endif
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+        simd_fill_sse2(d, buf, bytes);
+#else
+        simd_fill_scalar(d, buf, bytes);
+#endif
+        return true;
+    }
+
+    inline bool simd_fill(void* dst, const void* pattern, size_t size, size_t count) noexcept {
+        return simd_fill(dst, pattern, size, count, size * count);
+    }
+
+    // copy: medium sizes with wide unaligned loads and stores, beyond the streaming threshold
+    // prefetch the source and write the destination with non temporal stores
+#if TINYSTL_SIMD_X86
+    TINYSTL_TARGET_AVX2
+    inline void simd_copy_avx2(unsigned char* d, const unsigned char* s, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 128 <= bytes; i += 128) {
+            const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 32));
+            const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 64));
+            const __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + 96));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), v0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 32), v1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 64), v2);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i + 96), v3);
+        }
+        for (; i + 32 <= bytes; i += 32) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i)));
+        }
+        std::memcpy(d + i, s + i, bytes - i);
+    }
+#endif
+
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+    inline void simd_copy_stream(unsigned char* d, const unsigned char* s, size_t bytes) noexcept {
+        size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+        if (head > bytes) head = bytes;
+        std::memcpy(d, s, head);
+        size_t i = head;
+        for (; i + 64 <= bytes; i += 64) {
+            _mm_prefetch(reinterpret_cast<const char*>(s + i + 1024), _MM_HINT_NTA);
+            const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 16));
+            const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 32));
+            const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), v0);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 16), v1);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 32), v2);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i + 48), v3);
+        }
+        _mm_sfence();
+        std::memcpy(d + i, s + i, bytes - i);
+    }
+#endif
+
+    // memmove semantics, overlapping ranges take the memmove path.
+    // total is the byte size of the whole copy this call is a slice of, it decides whether to stream
+    inline void simd_copy(void* dst, const void* src, size_t bytes, size_t total) noexcept {
+        unsigned char* d = static_cast<unsigned char*>(dst);
+        const unsigned char* s = static_cast<const unsigned char*>(src);
+        if (bytes == 0) return;
+        if (d < s + bytes && s < d + bytes) { std::memmove(d, s, bytes); return; }
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+        if (total >= simd_streaming_threshold()) { simd_copy_stream(d, s, bytes); return; }
+#endif
+#if TINYSTL_SIMD_X86
+        if (bytes >= 256 && cpu_has_avx2()) { simd_copy_avx2(d, s, bytes); return; }
+#endif
+        std::memcpy(d, s, bytes);
+    }
+
+    inline void simd_copy(void* dst, const void* src, size_t bytes) noexcept { simd_copy(dst, src, bytes, bytes); }
+
+    // reverse copy: dst[i] = src[n - 1 - i] for n trivially copyable elements. a vector is loaded from the
+    // back of src, its lanes reversed and stored to the front of dst. the ranges must not overlap
+    template <class U>
+    inline void simd_reverse_copy_scalar(U* d, const U* s, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) d[i] = s[n - 1 - i];
+    }
+
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+    inline __m128i simd_reverse_lanes_sse2(__m128i v, size_t size) noexcept {
+        if (size == 8) return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        if (size == 4) return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+        // 2 byte lanes: reverse within each half, then swap the halves; single bytes swap inside each pair first
+        if (size == 1) v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    template <class U>
+    inline void simd_reverse_copy_sse2(U* d, const U* s, size_t n) noexcept {
+        const size_t lanes = 16 / sizeof(U);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - i - lanes));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), simd_reverse_lanes_sse2(v, sizeof(U)));
+        }
+        simd_reverse_copy_scalar(d + i, s, n - i);
+    }
+#endif
+
+#if TINYSTL_SIMD_X86
+    template <class U>
+    TINYSTL_TARGET_AVX2
+    inline void simd_reverse_copy_avx2(U* d, const U* s, size_t n) noexcept {
+        const size_t lanes = 32 / sizeof(U);
+        // byte shuffles reversing 1 or 2 byte lanes within each 128 bit half
+        const __m256i bytes = sizeof(U) == 1
+            ? _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+            : _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1, 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+        const __m256i words = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + n - i - lanes));
+            if (sizeof(U) == 8) v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+            else if (sizeof(U) == 4) v = _mm256_permutevar8x32_epi32(v, words);
+            else v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, bytes), _MM_SHUFFLE(1, 0, 3, 2));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), v);
+        }
+        simd_reverse_copy_scalar(d + i, s, n - i);
+    }
+#endif
+
+    // element sizes without a lane shuffle are copied one element at a time
+    template <bool Vector>
+    struct simd_reverse_dispatch {
+        template <class U>
+        static void run(U* d, const U* s, size_t n) noexcept { simd_reverse_copy_scalar(d, s, n); }
+    };
+
+    template <>
+    struct simd_reverse_dispatch<true> {
+        template <class U>
+        static void run(U* d, const U* s, size_t n) noexcept {
+#if TINYSTL_SIMD_X86
+            if (n * sizeof(U) >= 64 && cpu_has_avx2()) { simd_reverse_copy_avx2(d, s, n); return; }
+#endif
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+            simd_reverse_copy_sse2(d, s, n);
+#else
+            simd_reverse_copy_scalar(d, s, n);
+#endif
+        }
+    };
+
+    template <class U>
+    inline void simd_reverse_copy(U* dst, const U* src, size_t n) noexcept {
+        simd_reverse_dispatch<sizeof(U) == 1 || sizeof(U) == 2 || sizeof(U) == 4 || sizeof(U) == 8>::run(dst, src, n);
+    }
+
+
+    // stream compaction: keep(p, count) returns one bit per element of p[0, count), count <= 64, and is
+    // called once per chunk in order. the kept elements are packed to the front of dst, which needs room
+    // for n elements and may alias src at or before it; returns the number kept
+    const size_t simd_compact_chunk = 64;
+
+    // stores every element and advances the output by its bit, the scalar form of a compress
+    template <class T, class Keep>
+    inline size_t simd_compact_scalar(const T* src, size_t n, T* dst, Keep& keep) {
+        size_t o = 0;
+        for (size_t i = 0; i < n; i += simd_compact_chunk) {
+            const size_t count = n - i < simd_compact_chunk ? n - i : simd_compact_chunk;
+            const uint64_t m = keep(src + i, count);
+            for (size_t k = 0; k < count; ++k) { dst[o] = src[i + k]; o += static_cast<size_t>(m >> k) & 1; }
+        }
+        return o;
+    }
+
+#if TINYSTL_SIMD_X86
+    // lane permutations packing the set lanes of an 8 lane mask to the front, 3 bits per destination lane;
+    // 8 byte elements use the 4 lane masks as pairs of 4 byte lanes
+    struct simd_compress_table {
+        uint32_t lanes32[256];
+        uint32_t lanes64[16];
+        simd_compress_table() {
+            for (unsigned m = 0; m < 256; ++m) {
+                uint32_t packed = 0;
+                unsigned c = 0;
+                for (unsigned k = 0; k < 8; ++k) { if (m >> k & 1) packed |= k << (3 * c++); }
+                lanes32[m] = packed;
+            }
+            for (unsigned m = 0; m < 16; ++m) {
+                uint32_t packed = 0;
+                unsigned c = 0;
+                for (unsigned k = 0; k < 4; ++k) {
+                    if (m >> k & 1) { packed |= (2 * k) << (3 * c++); packed |= (2 * k + 1) << (3 * c++); }
+                }
+                lanes64[m] = packed;
+            }
+        }
+    };
+
+    inline const simd_compress_table& simd_compress_lut() {
+        static const simd_compress_table table;
+        return table;
+    }
+
+    // every block is loaded before its compressed store, which ends at or before the next block,
+    // so compacting in place never overwrites an unread element
+    template <class T, class Keep>
+    TINYSTL_TARGET_AVX2
+    inline size_t simd_compact_avx2(const T* src, size_t n, T* dst, Keep& keep) {
+        const simd_compress_table& lut = simd_compress_lut();
+        const __m256i shifts = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        const size_t lanes = 32 / sizeof(T);
+        size_t i = 0, o = 0;
+        for (; i + simd_compact_chunk <= n; i += simd_compact_chunk) {
+            const uint64_t m = keep(src + i, simd_compact_chunk);
+            for (size_t s = 0; s < simd_compact_chunk; s += lanes) {
+                const unsigned bits = static_cast<unsigned>(m >> s) & ((1u << lanes) - 1);
+                const uint32_t packed = sizeof(T) == 4 ? lut.lanes32[bits] : lut.lanes64[bits];
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + s));
+                const __m256i idx = _mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(packed)), shifts);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + o), _mm256_permutevar8x32_epi32(v, idx));
+                o += static_cast<size_t>(__builtin_popcount(bits));
+            }
+        }
+        return o + simd_compact_scalar(src + i, n - i, dst + o, keep);
+    }
+
+    template <class T, class Keep>
+    TINYSTL_TARGET_AVX512
+    inline size_t simd_compact_avx512(const T* src, size_t n, T* dst, Keep& keep) {
+        const size_t lanes = 64 / sizeof(T);
+        size_t i = 0, o = 0;
+        for (; i + simd_compact_chunk <= n; i += simd_compact_chunk) {
+            const uint64_t m = keep(src + i, simd_compact_chunk);
+            for (size_t s = 0; s < simd_compact_chunk; s += lanes) {
+                const unsigned bits = static_cast<unsigned>(m >> s) & ((1u << lanes) - 1);
+                const __m512i v = _mm512_loadu_si512(src + i + s);
+                // compress in a register and store the whole vector, a masked compress store is slow on some cores
+                const __m512i packed = sizeof(T) == 4 ? _mm512_maskz_compress_epi32(static_cast<__mmask16>(bits), v)
+                                                      : _mm512_maskz_compress_epi64(static_cast<__mmask8>(bits), v);
+                _mm512_storeu_si512(dst + o, packed);
+                o += static_cast<size_t>(__builtin_popcount(bits));
+            }
+        }
+        return o + simd_compact_scalar(src + i, n - i, dst + o, keep);
+    }
+#endif
+
+    // only 4 and 8 byte elements have vector kernels
+    template <size_t Size>
+    struct simd_compact_dispatch {
+        template <class T, class Keep>
+        static size_t run(const T* src, size_t n, T* dst, Keep& keep) { return simd_compact_scalar(src, n, dst, keep); }
+    };
+
+    struct simd_compact_vector {
+        template <class T, class Keep>
+        static size_t run(const T* src, size_t n, T* dst, Keep& keep) {
+#if TINYSTL_SIMD_X86
+            if (cpu_has_avx512()) return simd_compact_avx512(src, n, dst, keep);
+            if (cpu_has_avx2()) return simd_compact_avx2(src, n, dst, keep);
+#endif
+            return simd_compact_scalar(src, n, dst, keep);
+        }
+    };
+
+    template <>
+    struct simd_compact_dispatch<4> : simd_compact_vector {};
+    template <>
+    struct simd_compact_dispatch<8> : simd_compact_vector {};
+
+    template <class T, class Keep>
+    inline size_t simd_compact(const T* src, size_t n, T* dst, Keep& keep) {
+        return simd_compact_dispatch<sizeof(T)>::run(src, n, dst, keep);
+    }
+
+
+    // small sorts and merges: bitonic networks over up to 16 keys of 4 bytes held in two vectors, every stage
+    // is a lane permute, a min, a max and a blend. floats are sorted as signed integers in the same order,
+    // spare lanes hold the greatest key and end up past the last element
+    constexpr int simd_bitonic_mask(int k, int j, int i = 0) {
+        return i == 8 ? 0 : ((((i & j) != 0) == ((i & k) == 0)) ? 1 << i : 0) | simd_bitonic_mask(k, j, i + 1);
+    }
+
+    const size_t simd_network_lanes = 16;
+
+#if TINYSTL_SIMD_X86
+    template <bool Signed>
+    TINYSTL_TARGET_AVX2
+    inline __m256i simd_min32(__m256i a, __m256i b) noexcept { return Signed ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b); }
+    template <bool Signed>
+    TINYSTL_TARGET_AVX2
+    inline __m256i simd_max32(__m256i a, __m256i b) noexcept { return Signed ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b); }
+
+    // lanes in Mask take the greater of themselves and lane i ^ J
+    template <bool Signed, int J, int Mask>
+    TINYSTL_TARGET_AVX2
+    inline __m256i simd_bitonic_step(__m256i v) noexcept {
+        const __m256i p = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J));
+        return _mm256_blend_epi32(simd_min32<Signed>(v, p), simd_max32<Signed>(v, p), Mask);
+    }
+
+    // sorts a bitonic vector ascending
+    template <bool Signed>
+    TINYSTL_TARGET_AVX2
+    inline __m256i simd_bitonic_merge8(__m256i v) noexcept {
+        v = simd_bitonic_step<Signed, 4, simd_bitonic_mask(8, 4)>(v);
+        v = simd_bitonic_step<Signed, 2, simd_bitonic_mask(8, 2)>(v);
+        return simd_bitonic_step<Signed, 1, simd_bitonic_mask(8, 1)>(v);
+    }
+
+    template <bool Signed>
+    TINYSTL_TARGET_AVX2
+    inline __m256i simd_bitonic_sort8(__m256i v) noexcept {
+        v = simd_bitonic_step<Signed, 1, simd_bitonic_mask(2, 1)>(v);
+        v = simd_bitonic_step<Signed, 2, simd_bitonic_mask(4, 2)>(v);
+        v = simd_bitonic_step<Signed, 1, simd_bitonic_mask(4, 1)>(v);
+        return simd_bitonic_merge8<Signed>(v);
+    }
+
+    // two ascending vectors into the lower and the upper half of their union: against the other one reversed,
+    // the lane minima and maxima are two bitonic vectors
+    template <bool Signed>
+    TINYSTL_TARGET_AVX2
+    inline void simd_bitonic_merge16(__m256i& a, __m256i& b) noexcept {
+        const __m256i r = _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        const __m256i lo = simd_min32<Signed>(a, r);
+        b = simd_bitonic_merge8<Signed>(simd_max32<Signed>(a, r));
+        a = simd_bitonic_merge8<Signed>(lo);
+    }
+
+    // the sign bit selects flipping the other bits, which orders float bit patterns as signed integers
+    TINYSTL_TARGET_AVX2
+    inline __m256i simd_float_key(__m256i v) noexcept {
+        return _mm256_xor_si256(v, _mm256_and_si256(_mm256_srai_epi32(v, 31), _mm256_set1_epi32(0x7fffffff)));
+    }
+
+    // 8 to 16 keys in two full loads, the second one ending at the last key: its lanes that overlap the first
+    // are replaced by the greatest key, and after the sort it is rotated back and stored before the first
+    template <class T>
+    TINYSTL_TARGET_AVX2
+    inline void simd_sort16_avx2(T* p, size_t n) noexcept {
+        const bool signed_keys = !std::is_same<T, uint32_t>::value;
+        const bool float_keys = std::is_floating_point<T>::value;
+        const int shift = 16 - static_cast<int>(n);
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i pad = _mm256_set1_epi32(signed_keys ? 0x7fffffff : -1);
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + n - 8));
+        if (float_keys) { a = simd_float_key(a); b = simd_float_key(b); }
+        b = _mm256_blendv_epi8(b, pad, _mm256_cmpgt_epi32(_mm256_set1_epi32(shift), lanes));
+        a = simd_bitonic_sort8<signed_keys>(a);
+        b = simd_bitonic_sort8<signed_keys>(b);
+        simd_bitonic_merge16<signed_keys>(a, b);
+        b = _mm256_permutevar8x32_epi32(b, _mm256_sub_epi32(lanes, _mm256_set1_epi32(shift)));
+        if (float_keys) { a = simd_float_key(a); b = simd_float_key(b); }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + n - 8), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+    }
+
+    template <class T>
+    TINYSTL_TARGET_AVX2
+    inline void simd_merge16_avx2(const T* x, size_t nx, const T* y, size_t ny, T* out) noexcept {
+        const bool signed_keys = std::is_signed<T>::value;
+        alignas(32) T buf[simd_network_lanes];
+        for (size_t i = 0; i < simd_network_lanes; ++i) buf[i] = signed_keys ? static_cast<T>(0x7fffffff) : static_cast<T>(0xffffffffu);
+        std::memcpy(buf, x, nx * sizeof(T));
+        std::memcpy(buf + 8, y, ny * sizeof(T));
+        __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(buf));
+        __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(buf + 8));
+        simd_bitonic_merge16<signed_keys>(a, b);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(buf), a);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(buf + 8), b);
+        std::memcpy(out, buf, (nx + ny) * sizeof(T));
+    }
+#endif
+
+    // ascending sort of p[0, n) for int32_t, uint32_t and float keys, false unless n is 8 to 16 and the cpu has avx2
+    template <class T>
+    inline bool simd_sort_small(T* p, size_t n) noexcept {
+        static_assert(sizeof(T) == 4, "4 byte keys only");
+#if TINYSTL_SIMD_X86
+        if (n - 8 <= simd_network_lanes - 8 && cpu_has_avx2()) { simd_sort16_avx2(p, n); return true; }
+#else
+        (void)p; (void)n;
+#endif
+        return false;
+    }
+
+    // ascending merge of x[0, nx) and y[0, ny), nx and ny from 1 to 8, for int32_t and uint32_t keys; equal keys
+    // are identical, so the order the network leaves them in is the stable one
+    template <class T>
+    inline bool simd_merge_small(const T* x, size_t nx, const T* y, size_t ny, T* out) noexcept {
+        static_assert(sizeof(T) == 4 && std::is_integral<T>::value, "4 byte integer keys only");
+#if TINYSTL_SIMD_X86
+        if (nx - 1 < 8 && ny - 1 < 8 && cpu_has_avx2()) { simd_merge16_avx2(x, nx, y, ny, out); return true; }
+#else
+        (void)x; (void)nx; (void)y; (void)ny; (void)out;
+#endif
+        return false;
+    }
+
+}
+
+#endif //TINYSTL_SIMD_H_
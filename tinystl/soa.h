@@ -0,0 +1,461 @@
+#ifndef TINYSTL_SOA_H_
+#define TINYSTL_SOA_H_
+
+// struct of arrays container: every field of a record lives in its own array
+
+#include <cstddef>
+
+#include "allocator.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // soa value: one record, also used with pointer fields to hold the field arrays
+    template <class... Ts> struct soa_value;
+
+    template <>
+    struct soa_value<> {
+        soa_value() {}
+        soa_value(const soa_value&, size_t) {}
+    };
+
+    template <class H, class... Ts>
+    struct soa_value<H, Ts...> {
+        H head;
+        soa_value<Ts...> tail;
+
+        soa_value() : head(), tail() {}
+        soa_value(const H& h, const Ts&... ts) : head(h), tail(ts...) {}
+        template <class U, class... Us>
+        soa_value(const soa_value<U, Us...>& other) : head(other.head), tail(other.tail) {}
+        // load record i from the field arrays
+        template <class P>
+        soa_value(const P& arrays, size_t i) : head(arrays.head[i]), tail(arrays.tail, i) {}
+    };
+
+    // field type of index I
+    template <size_t I, class... Ts> struct soa_field;
+    template <class H, class... Ts>
+    struct soa_field<0, H, Ts...> { typedef H type; };
+    template <size_t I, class H, class... Ts>
+    struct soa_field<I, H, Ts...> : public soa_field<I - 1, Ts...> {};
+
+    template <size_t I>
+    struct soa_get_helper {
+        template <class S>
+        static auto get(S& s) -> decltype(soa_get_helper<I - 1>::get(s.tail)) { return soa_get_helper<I - 1>::get(s.tail); }
+    };
+    template <>
+    struct soa_get_helper<0> {
+        template <class S>
+        static auto get(S& s) -> decltype((s.head)) { return s.head; }
+    };
+
+    template <size_t I, class... Ts>
+    typename soa_field<I, Ts...>::type& get(soa_value<Ts...>& v) { return soa_get_helper<I>::get(v); }
+    template <size_t I, class... Ts>
+    const typename soa_field<I, Ts...>::type& get(const soa_value<Ts...>& v) { return soa_get_helper<I>::get(v); }
+
+    // overload operator, lexicographic over the fields
+    inline bool operator==(const soa_value<>&, const soa_value<>&) { return true; }
+    template <class H, class... Ts>
+    bool operator==(const soa_value<H, Ts...>& lhs, const soa_value<H, Ts...>& rhs) { return lhs.head == rhs.head && lhs.tail == rhs.tail; }
+    inline bool operator<(const soa_value<>&, const soa_value<>&) { return false; }
+    template <class H, class... Ts>
+    bool operator<(const soa_value<H, Ts...>& lhs, const soa_value<H, Ts...>& rhs) {
+        return lhs.head < rhs.head || (!(rhs.head < lhs.head) && lhs.tail < rhs.tail);
+    }
+    template <class... Ts>
+    bool operator!=(const soa_value<Ts...>& lhs, const soa_value<Ts...>& rhs) { return !(lhs == rhs); }
+    template <class... Ts>
+    bool operator>(const soa_value<Ts...>& lhs, const soa_value<Ts...>& rhs) { return rhs < lhs; }
+    template <class... Ts>
+    bool operator<=(const soa_value<Ts...>& lhs, const soa_value<Ts...>& rhs) { return !(rhs < lhs); }
+    template <class... Ts>
+    bool operator>=(const soa_value<Ts...>& lhs, const soa_value<Ts...>& rhs) { return !(lhs < rhs); }
+
+    // per field operations on the array pointers
+    inline void soa_allocate(soa_value<>&, size_t) {}
+    template <class H, class... Ts>
+    void soa_allocate(soa_value<H*, Ts*...>& arrays, size_t n) {
+        arrays.head = tinystl::allocator<H>::allocate(n);
+        try {
+            tinystl::soa_allocate(arrays.tail, n);
+        } catch (...) {
+            tinystl::allocator<H>::deallocate(arrays.head, n);
+            arrays.head = nullptr;
+            throw;
+        }
+    }
+
+    inline void soa_deallocate(soa_value<>&, size_t) {}
+    template <class H, class... Ts>
+    void soa_deallocate(soa_value<H*, Ts*...>& arrays, size_t n) {
+        tinystl::allocator<H>::deallocate(arrays.head, n);
+        arrays.head = nullptr;
+        tinystl::soa_deallocate(arrays.tail, n);
+    }
+
+    inline void soa_destroy(const soa_value<>&, size_t, size_t) {}
+    template <class H, class... Ts>
+    void soa_destroy(const soa_value<H*, Ts*...>& arrays, size_t first, size_t last) {
+        tinystl::destroy(arrays.head + first, arrays.head + last);
+        tinystl::soa_destroy(arrays.tail, first, last);
+    }
+
+    inline void soa_construct(const soa_value<>&, size_t, const soa_value<>&) {}
+    template <class H, class... Ts>
+    void soa_construct(const soa_value<H*, Ts*...>& arrays, size_t i, const soa_value<H, Ts...>& value) {
+        tinystl::construct(arrays.head + i, value.head);
+        try {
+            tinystl::soa_construct(arrays.tail, i, value.tail);
+        } catch (...) {
+            tinystl::destroy(arrays.head + i);
+            throw;
+        }
+    }
+
+    inline void soa_construct(const soa_value<>&, size_t, soa_value<>&&) {}
+    template <class H, class... Ts>
+    void soa_construct(const soa_value<H*, Ts*...>& arrays, size_t i, soa_value<H, Ts...>&& value) {
+        tinystl::construct(arrays.head + i, tinystl::move(value.head));
+        try {
+            tinystl::soa_construct(arrays.tail, i, tinystl::move(value.tail));
+        } catch (...) {
+            tinystl::destroy(arrays.head + i);
+            throw;
+        }
+    }
+
+    inline void soa_emplace(const soa_value<>&, size_t) {}
+    template <class H, class... Ts, class Arg, class... Args>
+    void soa_emplace(const soa_value<H*, Ts*...>& arrays, size_t i, Arg&& arg, Args&&... args) {
+        tinystl::construct(arrays.head + i, tinystl::forward<Arg>(arg));
+        try {
+            tinystl::soa_emplace(arrays.tail, i, tinystl::forward<Args>(args)...);
+        } catch (...) {
+            tinystl::destroy(arrays.head + i);
+            throw;
+        }
+    }
+
+    inline void soa_uninit_fill_n(const soa_value<>&, size_t, size_t, const soa_value<>&) {}
+    template <class H, class... Ts>
+    void soa_uninit_fill_n(const soa_value<H*, Ts*...>& arrays, size_t first, size_t n, const soa_value<H, Ts...>& value) {
+        tinystl::uninitialized_fill_n(arrays.head + first, n, value.head);
+        try {
+            tinystl::soa_uninit_fill_n(arrays.tail, first, n, value.tail);
+        } catch (...) {
+            tinystl::destroy(arrays.head + first, arrays.head + first + n);
+            throw;
+        }
+    }
+
+    inline void soa_uninit_copy_n(const soa_value<>&, size_t, const soa_value<>&) {}
+    template <class H, class... Ts>
+    void soa_uninit_copy_n(const soa_value<H*, Ts*...>& from, size_t n, const soa_value<H*, Ts*...>& to) {
+        tinystl::uninitialized_copy_n(from.head, n, to.head);
+        try {
+            tinystl::soa_uninit_copy_n(from.tail, n, to.tail);
+        } catch (...) {
+            tinystl::destroy(to.head, to.head + n);
+            throw;
+        }
+    }
+
+    inline void soa_uninit_move_n(const soa_value<>&, size_t, const soa_value<>&) {}
+    template <class H, class... Ts>
+    void soa_uninit_move_n(const soa_value<H*, Ts*...>& from, size_t n, const soa_value<H*, Ts*...>& to) {
+        tinystl::uninitialized_move_n(from.head, n, to.head);
+        try {
+            tinystl::soa_uninit_move_n(from.tail, n, to.tail);
+        } catch (...) {
+            tinystl::destroy(to.head, to.head + n);
+            throw;
+        }
+    }
+
+    // element wise assignment through the arrays
+    inline void soa_assign(const soa_value<>&, size_t, const soa_value<>&) {}
+    template <class H, class... Ts>
+    void soa_assign(const soa_value<H*, Ts*...>& arrays, size_t i, const soa_value<H, Ts...>& value) {
+        arrays.head[i] = value.head;
+        tinystl::soa_assign(arrays.tail, i, value.tail);
+    }
+
+    inline void soa_assign(const soa_value<>&, size_t, soa_value<>&&) {}
+    template <class H, class... Ts>
+    void soa_assign(const soa_value<H*, Ts*...>& arrays, size_t i, soa_value<H, Ts...>&& value) {
+        arrays.head[i] = tinystl::move(value.head);
+        tinystl::soa_assign(arrays.tail, i, tinystl::move(value.tail));
+    }
+
+    template <class P>
+    void soa_assign(const P&, size_t, const soa_value<>&, size_t) {}
+    template <class P, class H, class... Ts>
+    void soa_assign(const P& to, size_t i, const soa_value<H*, Ts*...>& from, size_t j) {
+        to.head[i] = from.head[j];
+        tinystl::soa_assign(to.tail, i, from.tail, j);
+    }
+
+    inline void soa_swap(const soa_value<>&, size_t, const soa_value<>&, size_t) {}
+    template <class H, class... Ts>
+    void soa_swap(const soa_value<H*, Ts*...>& lhs, size_t i, const soa_value<H*, Ts*...>& rhs, size_t j) {
+        tinystl::swap(lhs.head[i], rhs.head[j]);
+        tinystl::soa_swap(lhs.tail, i, rhs.tail, j);
+    }
+
+    // soa reference: proxy for one record, assignment writes through to every field array
+    template <class... Ts>
+    class soa_reference {
+    public:
+        typedef soa_value<typename std::remove_const<Ts>::type...> value_type;
+        typedef soa_value<Ts*...> arrays_type;
+        typedef soa_reference<Ts...> self;
+
+    private:
+        arrays_type arrays;
+        size_t index;
+
+        template <class...> friend class soa_reference;
+
+    public:
+        soa_reference(const arrays_type& a, size_t i) : arrays(a), index(i) {}
+        soa_reference(const self& rhs) = default;
+
+        operator value_type() const { return value_type(arrays, index); }
+
+        template <size_t I>
+        typename soa_field<I, Ts...>::type& get() const { return soa_get_helper<I>::get(arrays)[index]; }
+
+        const self& operator=(const self& rhs) const { tinystl::soa_assign(arrays, index, rhs.arrays, rhs.index); return *this; }
+        template <class... Us>
+        const self& operator=(const soa_reference<Us...>& rhs) const { tinystl::soa_assign(arrays, index, rhs.arrays, rhs.index); return *this; }
+        const self& operator=(const value_type& value) const { tinystl::soa_assign(arrays, index, value); return *this; }
+        const self& operator=(value_type&& value) const { tinystl::soa_assign(arrays, index, tinystl::move(value)); return *this; }
+
+        // swaps the two records field by field
+        void swap(const self& rhs) const { tinystl::soa_swap(arrays, index, rhs.arrays, rhs.index); }
+
+        friend bool operator==(const self& lhs, const self& rhs) { return value_type(lhs) == value_type(rhs); }
+        friend bool operator==(const self& lhs, const value_type& rhs) { return value_type(lhs) == rhs; }
+        friend bool operator==(const value_type& lhs, const self& rhs) { return lhs == value_type(rhs); }
+        friend bool operator!=(const self& lhs, const self& rhs) { return !(lhs == rhs); }
+        friend bool operator!=(const self& lhs, const value_type& rhs) { return !(lhs == rhs); }
+        friend bool operator!=(const value_type& lhs, const self& rhs) { return !(lhs == rhs); }
+        friend bool operator<(const self& lhs, const self& rhs) { return value_type(lhs) < value_type(rhs); }
+        friend bool operator<(const self& lhs, const value_type& rhs) { return value_type(lhs) < rhs; }
+        friend bool operator<(const value_type& lhs, const self& rhs) { return lhs < value_type(rhs); }
+    };
+
+    // overload swap: the references are prvalues, swap(T&, T&) cannot bind them
+    template <class... Ts>
+    void swap(const soa_reference<Ts...>& lhs, const soa_reference<Ts...>& rhs) { lhs.swap(rhs); }
+
+    // soa iterator: random access over record indices
+    template <bool Const, class... Ts>
+    class soa_iterator : public iterator<random_access_iterator_tag, soa_value<Ts...>, ptrdiff_t, void,
+        soa_reference<typename std::conditional<Const, const Ts, Ts>::type...>> {
+    public:
+        typedef soa_reference<typename std::conditional<Const, const Ts, Ts>::type...> reference;
+        typedef typename reference::arrays_type arrays_type;
+        typedef ptrdiff_t difference_type;
+        typedef soa_iterator<Const, Ts...> self;
+
+    private:
+        arrays_type arrays;
+        ptrdiff_t index;
+
+        template <bool, class...> friend class soa_iterator;
+
+    public:
+        soa_iterator() : arrays(), index(0) {}
+        soa_iterator(const arrays_type& a, ptrdiff_t i) : arrays(a), index(i) {}
+        // iterator to const iterator; a template, so the implicit copy operations stay
+        template <bool C, class = typename std::enable_if<Const && !C>::type>
+        soa_iterator(const soa_iterator<C, Ts...>& rhs) : arrays(rhs.arrays), index(rhs.index) {}
+
+        reference operator*() const { return reference(arrays, static_cast<size_t>(index)); }
+        reference operator[](difference_type n) const { return reference(arrays, static_cast<size_t>(index + n)); }
+
+        self& operator++() { ++index; return *this; }
+        self operator++(int) { self tmp = *this; ++index; return tmp; }
+        self& operator--() { --index; return *this; }
+        self operator--(int) { self tmp = *this; --index; return tmp; }
+        self& operator+=(difference_type n) { index += n; return *this; }
+        self& operator-=(difference_type n) { index -= n; return *this; }
+        self operator+(difference_type n) const { return self(arrays, index + n); }
+        self operator-(difference_type n) const { return self(arrays, index - n); }
+
+        // iterator and const iterator mix in differences and comparisons
+        template <bool C>
+        difference_type operator-(const soa_iterator<C, Ts...>& rhs) const { return index - rhs.index; }
+
+        template <bool C>
+        bool operator==(const soa_iterator<C, Ts...>& rhs) const { return index == rhs.index; }
+        template <bool C>
+        bool operator!=(const soa_iterator<C, Ts...>& rhs) const { return index != rhs.index; }
+        template <bool C>
+        bool operator<(const soa_iterator<C, Ts...>& rhs) const { return index < rhs.index; }
+        template <bool C>
+        bool operator>(const soa_iterator<C, Ts...>& rhs) const { return index > rhs.index; }
+        template <bool C>
+        bool operator<=(const soa_iterator<C, Ts...>& rhs) const { return index <= rhs.index; }
+        template <bool C>
+        bool operator>=(const soa_iterator<C, Ts...>& rhs) const { return index >= rhs.index; }
+    };
+
+    template <bool Const, class... Ts>
+    soa_iterator<Const, Ts...> operator+(ptrdiff_t n, const soa_iterator<Const, Ts...>& it) { return it + n; }
+
+    // iterator swap: swaps whole records, every field array
+    template <class... Ts>
+    void iter_swap(soa_iterator<false, Ts...> lhs, soa_iterator<false, Ts...> rhs) { tinystl::swap(*lhs, *rhs); }
+
+    // class: soa vector
+    // data<I>() exposes field I as a plain contiguous array, so per field loops vectorise
+    template <class... Ts>
+    class soa_vector {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one field");
+
+    public:
+        typedef soa_value<Ts...>                value_type;
+        typedef soa_reference<Ts...>            reference;
+        typedef soa_reference<const Ts...>      const_reference;
+        typedef soa_iterator<false, Ts...>      iterator;
+        typedef soa_iterator<true, Ts...>       const_iterator;
+        typedef size_t                          size_type;
+        typedef ptrdiff_t                       difference_type;
+
+        template <size_t I>
+        using field_type = typename soa_field<I, Ts...>::type;
+
+    private:
+        soa_value<Ts*...> arrays;
+        size_type len;
+        size_type cap;
+
+    public:
+        soa_vector() noexcept : arrays(), len(0), cap(0) {}
+        explicit soa_vector(size_type n) : arrays(), len(0), cap(0) { fill_init(n, value_type()); }
+        soa_vector(size_type n, const value_type& value) : arrays(), len(0), cap(0) { fill_init(n, value); }
+        soa_vector(const soa_vector& rhs);
+        soa_vector(soa_vector&& rhs) noexcept : arrays(rhs.arrays), len(rhs.len), cap(rhs.cap) {
+            rhs.arrays = soa_value<Ts*...>();
+            rhs.len = rhs.cap = 0;
+        }
+        ~soa_vector() { tinystl::soa_destroy(arrays, 0, len); tinystl::soa_deallocate(arrays, cap); }
+
+        soa_vector& operator=(const soa_vector& rhs) { soa_vector tmp(rhs); swap(tmp); return *this; }
+        soa_vector& operator=(soa_vector&& rhs) noexcept { soa_vector tmp(tinystl::move(rhs)); swap(tmp); return *this; }
+
+    public:
+        iterator begin() noexcept { return iterator(arrays, 0); }
+        iterator end() noexcept { return iterator(arrays, static_cast<difference_type>(len)); }
+        const_iterator begin() const noexcept { return const_iterator(arrays, 0); }
+        const_iterator end() const noexcept { return const_iterator(arrays, static_cast<difference_type>(len)); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        size_type size() const noexcept { return len; }
+        size_type capacity() const noexcept { return cap; }
+        bool empty() const noexcept { return len == 0; }
+
+        reference operator[](size_type n) { return reference(arrays, n); }
+        const_reference operator[](size_type n) const { return const_reference(arrays, n); }
+        reference front() { return reference(arrays, 0); }
+        reference back() { return reference(arrays, len - 1); }
+
+        template <size_t I>
+        field_type<I>* data() noexcept { return soa_get_helper<I>::get(arrays); }
+        template <size_t I>
+        const field_type<I>* data() const noexcept { return soa_get_helper<I>::get(arrays); }
+
+        void reserve(size_type n);
+        void resize(size_type n) { resize(n, value_type()); }
+        void resize(size_type n, const value_type& value);
+        void clear() noexcept { tinystl::soa_destroy(arrays, 0, len); len = 0; }
+
+        void push_back(const value_type& value) { grow_for_one(); tinystl::soa_construct(arrays, len, value); ++len; }
+        void push_back(value_type&& value) { grow_for_one(); tinystl::soa_construct(arrays, len, tinystl::move(value)); ++len; }
+        // one constructor argument per field
+        template <class... Args>
+        void emplace_back(Args&&... args) {
+            static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per field");
+            grow_for_one();
+            tinystl::soa_emplace(arrays, len, tinystl::forward<Args>(args)...);
+            ++len;
+        }
+        void pop_back() { --len; tinystl::soa_destroy(arrays, len, len + 1); }
+
+        void swap(soa_vector& rhs) noexcept {
+            tinystl::swap(arrays, rhs.arrays);
+            tinystl::swap(len, rhs.len);
+            tinystl::swap(cap, rhs.cap);
+        }
+
+    private:
+        void fill_init(size_type n, const value_type& value);
+        void grow_for_one() { if (len == cap) reserve(cap == 0 ? 16 : cap * 2); }
+    };
+
+    template <class... Ts>
+    soa_vector<Ts...>::soa_vector(const soa_vector& rhs) : arrays(), len(0), cap(0) {
+        if (rhs.len == 0) return;
+        tinystl::soa_allocate(arrays, rhs.len);
+        try {
+            tinystl::soa_uninit_copy_n(rhs.arrays, rhs.len, arrays);
+        } catch (...) {
+            tinystl::soa_deallocate(arrays, rhs.len);
+            throw;
+        }
+        len = cap = rhs.len;
+    }
+
+    template <class... Ts>
+    void soa_vector<Ts...>::fill_init(size_type n, const value_type& value) {
+        if (n == 0) return;
+        tinystl::soa_allocate(arrays, n);
+        try {
+            tinystl::soa_uninit_fill_n(arrays, 0, n, value);
+        } catch (...) {
+            tinystl::soa_deallocate(arrays, n);
+            throw;
+        }
+        len = cap = n;
+    }
+
+    template <class... Ts>
+    void soa_vector<Ts...>::reserve(size_type n) {
+        if (n <= cap) return;
+        soa_value<Ts*...> new_arrays;
+        tinystl::soa_allocate(new_arrays, n);
+        try {
+            tinystl::soa_uninit_move_n(arrays, len, new_arrays);
+        } catch (...) {
+            tinystl::soa_deallocate(new_arrays, n);
+            throw;
+        }
+        tinystl::soa_destroy(arrays, 0, len);
+        tinystl::soa_deallocate(arrays, cap);
+        arrays = new_arrays;
+        cap = n;
+    }
+
+    template <class... Ts>
+    void soa_vector<Ts...>::resize(size_type n, const value_type& value) {
+        if (n < len) { tinystl::soa_destroy(arrays, n, len); len = n; return; }
+        reserve(n);
+        tinystl::soa_uninit_fill_n(arrays, len, n - len, value);
+        len = n;
+    }
+
+    // overload swap
+    template <class... Ts>
+    void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept { lhs.swap(rhs); }
+
+}
+
+#endif //TINYSTL_SOA_H_
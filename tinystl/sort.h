@@ -0,0 +1,547 @@
+#ifndef TINYSTL_SORT_H_
+#define TINYSTL_SORT_H_
+
+// sorting: pattern defeating quicksort with heap sort as the worst case fallback,
+// and a natural merge sort that finds existing runs for stable sorting
+
+#include <cstddef>
+
+#include "algobase.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "iterator.h"
+#include "merge.h"
+#include "sort_network.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // partitions below this size are finished by insertion sort
+    const ptrdiff_t sort_insertion_threshold = 24;
+    // partitions up to this size are finished by a sorting network when comparisons are branchless
+    const ptrdiff_t sort_network_threshold = 16;
+    // above this size the pivot is a pseudo median of nine
+    const ptrdiff_t sort_ninther_threshold = 128;
+    // partial insertion sort gives up after moving this many elements
+    const ptrdiff_t sort_partial_insertion_limit = 8;
+    // elements classified per block by the branchless partition
+    const size_t sort_block_size = 64;
+
+    template <class Size>
+    int sort_log2(Size n) {
+        int r = 0;
+        while (n > 1) { n >>= 1; ++r; }
+        return r;
+    }
+
+    template <class RandomIter, class Compared>
+    void sort2(RandomIter a, RandomIter b, Compared comp) {
+        if (comp(*b, *a)) tinystl::iter_swap(a, b);
+    }
+
+    template <class RandomIter, class Compared>
+    void sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp) {
+        tinystl::sort2(a, b, comp);
+        tinystl::sort2(b, c, comp);
+        tinystl::sort2(a, b, comp);
+    }
+
+    template <class BidirectionalIter>
+    void sort_reverse(BidirectionalIter first, BidirectionalIter last) {
+        while (first != last && first != --last) { tinystl::iter_swap(first, last); ++first; }
+    }
+
+    // insertion sort
+    template <class RandomIter, class Compared>
+    void insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (first == last) return;
+        for (RandomIter cur = first + 1; cur != last; ++cur) {
+            RandomIter hole = cur;
+            RandomIter prev = cur - 1;
+            if (comp(*hole, *prev)) {
+                value_type tmp(tinystl::move(*hole));
+                do { *hole-- = tinystl::move(*prev); } while (hole != first && comp(tmp, *--prev));
+                *hole = tinystl::move(tmp);
+            }
+        }
+    }
+
+    // the element before first must not be greater than any element of the range
+    template <class RandomIter, class Compared>
+    void unguarded_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (first == last) return;
+        for (RandomIter cur = first + 1; cur != last; ++cur) {
+            RandomIter hole = cur;
+            RandomIter prev = cur - 1;
+            if (comp(*hole, *prev)) {
+                value_type tmp(tinystl::move(*hole));
+                do { *hole-- = tinystl::move(*prev); } while (comp(tmp, *--prev));
+                *hole = tinystl::move(tmp);
+            }
+        }
+    }
+
+    // insertion sort that stops once it has moved too many elements, true if the range ended up sorted
+    template <class RandomIter, class Compared>
+    bool partial_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (first == last) return true;
+        ptrdiff_t moved = 0;
+        for (RandomIter cur = first + 1; cur != last; ++cur) {
+            RandomIter hole = cur;
+            RandomIter prev = cur - 1;
+            if (comp(*hole, *prev)) {
+                value_type tmp(tinystl::move(*hole));
+                do { *hole-- = tinystl::move(*prev); } while (hole != first && comp(tmp, *--prev));
+                *hole = tinystl::move(tmp);
+                moved += cur - hole;
+            }
+            if (moved > sort_partial_insertion_limit) return false;
+        }
+        return true;
+    }
+
+    // sorting networks: the unrolled network for each size up to sort_network_threshold,
+    // or the vector network for 4 byte keys from 8 elements up
+    template <class RandomIter, class Compared>
+    void network_sort(RandomIter first, ptrdiff_t n, Compared comp) {
+        static_assert(sort_network_threshold == 16, "network_sort covers sizes up to 16");
+        if (tinystl::network_sort_simd(tinystl::unwrap_iter(first), n, comp)) return;
+        switch (n) {
+            case 2: tinystl::static_sort<2>(first, comp); break;
+            case 3: tinystl::static_sort<3>(first, comp); break;
+            case 4: tinystl::static_sort<4>(first, comp); break;
+            case 5: tinystl::static_sort<5>(first, comp); break;
+            case 6: tinystl::static_sort<6>(first, comp); break;
+            case 7: tinystl::static_sort<7>(first, comp); break;
+            case 8: tinystl::static_sort<8>(first, comp); break;
+            case 9: tinystl::static_sort<9>(first, comp); break;
+            case 10: tinystl::static_sort<10>(first, comp); break;
+            case 11: tinystl::static_sort<11>(first, comp); break;
+            case 12: tinystl::static_sort<12>(first, comp); break;
+            case 13: tinystl::static_sort<13>(first, comp); break;
+            case 14: tinystl::static_sort<14>(first, comp); break;
+            case 15: tinystl::static_sort<15>(first, comp); break;
+            case 16: tinystl::static_sort<16>(first, comp); break;
+            default: break;
+        }
+    }
+
+    // finish a small partition
+    template <class RandomIter, class Compared>
+    bool sort_small(RandomIter first, RandomIter last, Compared comp, bool leftmost, tinystl::false_type) {
+        if (last - first >= sort_insertion_threshold) return false;
+        if (leftmost) tinystl::insertion_sort(first, last, comp);
+        else tinystl::unguarded_insertion_sort(first, last, comp);
+        return true;
+    }
+
+    template <class RandomIter, class Compared>
+    bool sort_small(RandomIter first, RandomIter last, Compared comp, bool leftmost, tinystl::true_type) {
+        const ptrdiff_t n = last - first;
+        if (n <= sort_network_threshold) { tinystl::network_sort(first, n, comp); return true; }
+        return tinystl::sort_small(first, last, comp, leftmost, tinystl::false_type());
+    }
+
+    // partition around *first, elements equal to the pivot go right.
+    // returns the pivot position and whether the range was already partitioned
+    template <class RandomIter, class Compared>
+    tinystl::pair<RandomIter, bool> partition_right(RandomIter begin, RandomIter end, Compared comp, tinystl::false_type) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        value_type pivot(tinystl::move(*begin));
+        RandomIter first = begin;
+        RandomIter last = end;
+        // the median selection guarantees an element not less than the pivot at the end
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) { while (first < last && !comp(*--last, pivot)); }
+        else { while (!comp(*--last, pivot)); }
+        const bool already_partitioned = first >= last;
+        while (first < last) {
+            tinystl::iter_swap(first, last);
+            while (comp(*++first, pivot));
+            while (!comp(*--last, pivot));
+        }
+        RandomIter pivot_pos = first - 1;
+        *begin = tinystl::move(*pivot_pos);
+        *pivot_pos = tinystl::move(pivot);
+        return tinystl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+    }
+
+    // exchange the misplaced elements found by the block scans, a cyclic permutation when the counts differ
+    template <class RandomIter>
+    void swap_offsets(RandomIter first, RandomIter last, const unsigned char* offsets_l, const unsigned char* offsets_r, size_t num, bool use_swaps) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (use_swaps) {
+            for (size_t i = 0; i < num; ++i) tinystl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        } else if (num > 0) {
+            RandomIter l = first + offsets_l[0];
+            RandomIter r = last - offsets_r[0];
+            value_type tmp(tinystl::move(*l));
+            *l = tinystl::move(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = first + offsets_l[i];
+                *r = tinystl::move(*l);
+                r = last - offsets_r[i];
+                *l = tinystl::move(*r);
+            }
+            *r = tinystl::move(tmp);
+        }
+    }
+
+    // block partition: each side first records the offsets of misplaced elements for a whole block,
+    // storing unconditionally and advancing the count by the comparison result, then swaps them in bulk
+    template <class RandomIter, class Compared>
+    tinystl::pair<RandomIter, bool> partition_right(RandomIter begin, RandomIter end, Compared comp, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        value_type pivot(tinystl::move(*begin));
+        RandomIter first = begin;
+        RandomIter last = end;
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) { while (first < last && !comp(*--last, pivot)); }
+        else { while (!comp(*--last, pivot)); }
+        const bool already_partitioned = first >= last;
+        if (!already_partitioned) {
+            tinystl::iter_swap(first, last);
+            ++first;
+            alignas(64) unsigned char offsets_l[sort_block_size];
+            alignas(64) unsigned char offsets_r[sort_block_size];
+            RandomIter base_l = first;
+            RandomIter base_r = last;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+            while (first < last) {
+                // refill whichever side ran out; split the rest evenly when both did
+                const size_t unknown = static_cast<size_t>(last - first);
+                const size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+                const size_t split_r = num_r == 0 ? unknown - split_l : 0;
+                if (split_l >= sort_block_size) {
+                    for (size_t i = 0; i < sort_block_size;) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                        offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    }
+                } else {
+                    for (size_t i = 0; i < split_l;) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                    }
+                }
+                if (split_r >= sort_block_size) {
+                    for (size_t i = 0; i < sort_block_size;) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    }
+                } else {
+                    for (size_t i = 0; i < split_r;) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                    }
+                }
+                const size_t num = num_l < num_r ? num_l : num_r;
+                tinystl::swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (num_l == 0) { start_l = 0; base_l = first; }
+                if (num_r == 0) { start_r = 0; base_r = last; }
+            }
+            // at most one side has leftovers, move them next to the boundary
+            if (num_l) {
+                const unsigned char* off = offsets_l + start_l;
+                while (num_l--) tinystl::iter_swap(base_l + off[num_l], --last);
+                first = last;
+            }
+            if (num_r) {
+                const unsigned char* off = offsets_r + start_r;
+                while (num_r--) { tinystl::iter_swap(base_r - off[num_r], first); ++first; }
+                last = first;
+            }
+        }
+        RandomIter pivot_pos = first - 1;
+        *begin = tinystl::move(*pivot_pos);
+        *pivot_pos = tinystl::move(pivot);
+        return tinystl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+    }
+
+    // partition around *first, elements equal to the pivot go left.
+    // used when the pivot equals the element before the range, so the left side is a run of equal keys
+    template <class RandomIter, class Compared>
+    RandomIter partition_left(RandomIter begin, RandomIter end, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        value_type pivot(tinystl::move(*begin));
+        RandomIter first = begin;
+        RandomIter last = end;
+        while (comp(pivot, *--last));
+        if (last + 1 == end) { while (first < last && !comp(pivot, *++first)); }
+        else { while (!comp(pivot, *++first)); }
+        while (first < last) {
+            tinystl::iter_swap(first, last);
+            while (comp(pivot, *--last));
+            while (!comp(pivot, *++first));
+        }
+        *begin = tinystl::move(*last);
+        *last = tinystl::move(pivot);
+        return last;
+    }
+
+    // move the median of three, or a pseudo median of nine for large ranges, to *first
+    template <class RandomIter, class Compared>
+    void sort_choose_pivot(RandomIter first, RandomIter last, Compared comp) {
+        const auto n = last - first;
+        const auto half = n / 2;
+        if (n > sort_ninther_threshold) {
+            tinystl::sort3(first, first + half, last - 1, comp);
+            tinystl::sort3(first + 1, first + (half - 1), last - 2, comp);
+            tinystl::sort3(first + 2, first + (half + 1), last - 3, comp);
+            tinystl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            tinystl::iter_swap(first, first + half);
+        } else {
+            tinystl::sort3(first + half, first, last - 1, comp);
+        }
+    }
+
+    // swap a few elements of an unbalanced side to break the pattern that caused it
+    template <class RandomIter>
+    void sort_break_patterns(RandomIter first, RandomIter last) {
+        const auto n = last - first;
+        if (n < sort_insertion_threshold) return;
+        const auto quarter = n / 4;
+        tinystl::iter_swap(first, first + quarter);
+        tinystl::iter_swap(last - 1, last - quarter);
+        if (n > sort_ninther_threshold) {
+            tinystl::iter_swap(first + 1, first + (quarter + 1));
+            tinystl::iter_swap(first + 2, first + (quarter + 2));
+            tinystl::iter_swap(last - 2, last - (quarter + 1));
+            tinystl::iter_swap(last - 3, last - (quarter + 2));
+        }
+    }
+
+    // pattern defeating quicksort: recurse on the left part, loop on the right part
+    template <class RandomIter, class Compared, class Branchless>
+    void sort_loop(RandomIter first, RandomIter last, Compared comp, int bad_allowed, bool leftmost, Branchless branchless) {
+        while (true) {
+            const auto n = last - first;
+            if (tinystl::sort_small(first, last, comp, leftmost, branchless)) return;
+            tinystl::sort_choose_pivot(first, last, comp);
+            // the pivot equals an earlier pivot: every element equal to it is placed, skip them all
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = tinystl::partition_left(first, last, comp) + 1;
+                continue;
+            }
+            const tinystl::pair<RandomIter, bool> part = tinystl::partition_right(first, last, comp, branchless);
+            const RandomIter pivot = part.first;
+            const auto l_size = pivot - first;
+            const auto r_size = last - (pivot + 1);
+            if (l_size < n / 8 || r_size < n / 8) {
+                if (--bad_allowed == 0) {
+                    tinystl::make_heap(first, last, comp);
+                    tinystl::sort_heap(first, last, comp);
+                    return;
+                }
+                tinystl::sort_break_patterns(first, pivot);
+                tinystl::sort_break_patterns(pivot + 1, last);
+            } else if (part.second && tinystl::partial_insertion_sort(first, pivot, comp) &&
+                       tinystl::partial_insertion_sort(pivot + 1, last, comp)) {
+                // no element crossed the pivot and both sides were nearly sorted
+                return;
+            }
+            tinystl::sort_loop(first, pivot, comp, bad_allowed, leftmost, branchless);
+            first = pivot + 1;
+            leftmost = false;
+        }
+    }
+
+    // finish ranges that are one ascending or one descending run in a single pass
+    template <class RandomIter, class Compared>
+    bool sort_presorted(RandomIter first, RandomIter last, Compared comp) {
+        RandomIter cur = first + 1;
+        if (comp(*cur, *first)) {
+            while (++cur != last && !comp(*(cur - 1), *cur));
+            if (cur != last) return false;
+            tinystl::sort_reverse(first, last);
+            return true;
+        }
+        while (++cur != last && !comp(*cur, *(cur - 1)));
+        return cur == last;
+    }
+
+    // sort
+    template <class RandomIter, class Compared>
+    void sort(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2 || tinystl::sort_presorted(first, last, comp)) return;
+        tinystl::sort_loop(first, last, comp, tinystl::sort_log2(last - first), true, is_branchless_sortable<value_type, Compared>());
+    }
+
+    template <class RandomIter>
+    void sort(RandomIter first, RandomIter last) {
+        tinystl::sort(first, last, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // stable sort: natural merge sort in the manner of timsort. existing ascending runs, and strictly
+    // descending runs reversed in place, are extended to a minimum length by insertion sort and merged
+    // by merge_adaptive while the run lengths on the stack keep the merges balanced
+    template <class RandomIter, class Compared>
+    RandomIter stable_sort_run(RandomIter first, RandomIter last, Compared comp) {
+        RandomIter cur = first + 1;
+        if (cur == last) return cur;
+        if (comp(*cur, *first)) {
+            while (++cur != last && comp(*cur, *(cur - 1)));
+            tinystl::sort_reverse(first, cur);
+        } else {
+            while (++cur != last && !comp(*cur, *(cur - 1)));
+        }
+        return cur;
+    }
+
+    // between 32 and 64 so that n / minrun is a power of two or slightly less
+    template <class Distance>
+    Distance stable_sort_min_run(Distance n) {
+        Distance r = 0;
+        while (n >= 64) { r |= n & 1; n >>= 1; }
+        return n + r;
+    }
+
+    template <class RandomIter, class Compared>
+    void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type n = last - first;
+        if (n < 2) return;
+        if (n < sort_insertion_threshold) { tinystl::insertion_sort(first, last, comp); return; }
+
+        // a merge never needs more than the shorter run
+        temporary_buffer<RandomIter, value_type> buf(first, first + (n + 1) / 2);
+        value_type* const buffer = buf.begin();
+        const ptrdiff_t buffer_size = buf.size();
+        const difference_type min_run = tinystl::stable_sort_min_run(n);
+
+        // each run is at least as long as the two above it together, so 64 levels cover any range
+        RandomIter run_base[64];
+        difference_type run_len[64];
+        int runs = 0;
+        RandomIter cur = first;
+        while (cur != last) {
+            RandomIter run_end = tinystl::stable_sort_run(cur, last, comp);
+            if (run_end - cur < min_run) {
+                run_end = last - cur <= min_run ? last : cur + min_run;
+                tinystl::insertion_sort(cur, run_end, comp);
+            }
+            run_base[runs] = cur;
+            run_len[runs] = run_end - cur;
+            ++runs;
+            cur = run_end;
+            // restore len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i] for the top of the stack
+            while (runs > 1) {
+                int i = runs - 2;
+                if ((i > 0 && run_len[i - 1] <= run_len[i] + run_len[i + 1]) ||
+                    (i > 1 && run_len[i - 2] <= run_len[i - 1] + run_len[i])) {
+                    if (run_len[i - 1] < run_len[i + 1]) --i;
+                } else if (run_len[i] > run_len[i + 1]) {
+                    break;
+                }
+                tinystl::merge_adaptive(run_base[i], run_base[i + 1], run_base[i + 1] + run_len[i + 1], buffer, buffer_size, comp);
+                run_len[i] += run_len[i + 1];
+                for (int j = i + 1; j + 1 < runs; ++j) { run_base[j] = run_base[j + 1]; run_len[j] = run_len[j + 1]; }
+                --runs;
+            }
+        }
+        while (runs > 1) {
+            int i = runs - 2;
+            if (i > 0 && run_len[i - 1] < run_len[i + 1]) --i;
+            tinystl::merge_adaptive(run_base[i], run_base[i + 1], run_base[i + 1] + run_len[i + 1], buffer, buffer_size, comp);
+            run_len[i] += run_len[i + 1];
+            for (int j = i + 1; j + 1 < runs; ++j) { run_base[j] = run_base[j + 1]; run_len[j] = run_len[j + 1]; }
+            --runs;
+        }
+    }
+
+    template <class RandomIter>
+    void stable_sort(RandomIter first, RandomIter last) {
+        tinystl::stable_sort(first, last, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // partial sort: keep the smallest elements in a max heap over [first, middle), then sort the heap
+    template <class RandomIter, class Compared>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (first == middle) return;
+        tinystl::make_heap(first, middle, comp);
+        for (RandomIter i = middle; i < last; ++i) {
+            if (comp(*i, *first)) tinystl::pop_heap_aux(first, middle, i, value_type(*i), distance_type(first), comp);
+        }
+        tinystl::sort_heap(first, middle, comp);
+    }
+
+    template <class RandomIter>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
+        tinystl::partial_sort(first, middle, last, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // partial sort copy: a heap of the first elements in the output, any later element that does not beat
+    // the heap root is rejected with one comparison
+    template <class InputIter, class RandomIter, class Compared>
+    RandomIter partial_sort_copy(InputIter first, InputIter last, RandomIter result_first, RandomIter result_last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        if (result_first == result_last) return result_last;
+        RandomIter result_end = result_first;
+        for (; first != last && result_end != result_last; ++first, ++result_end) *result_end = *first;
+        tinystl::make_heap(result_first, result_end, comp);
+        const difference_type len = result_end - result_first;
+        for (; first != last; ++first) {
+            if (comp(*first, *result_first)) tinystl::adjust_heap(result_first, static_cast<difference_type>(0), len, value_type(*first), comp);
+        }
+        tinystl::sort_heap(result_first, result_end, comp);
+        return result_end;
+    }
+
+    template <class InputIter, class RandomIter>
+    RandomIter partial_sort_copy(InputIter first, InputIter last, RandomIter result_first, RandomIter result_last) {
+        return tinystl::partial_sort_copy(first, last, result_first, result_last, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // nth element: quickselect on the sort partitions, heap selection once the partitions keep coming out unbalanced
+    template <class RandomIter, class Compared>
+    void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (first == last || nth == last) return;
+        const is_branchless_sortable<value_type, Compared> branchless = is_branchless_sortable<value_type, Compared>();
+        int bad_allowed = tinystl::sort_log2(last - first);
+        bool leftmost = true;
+        while (last - first >= sort_insertion_threshold) {
+            const auto n = last - first;
+            tinystl::sort_choose_pivot(first, last, comp);
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                const RandomIter equal_end = tinystl::partition_left(first, last, comp);
+                if (nth <= equal_end) return;
+                first = equal_end + 1;
+                continue;
+            }
+            const RandomIter pivot = tinystl::partition_right(first, last, comp, branchless).first;
+            if (pivot == nth) return;
+            if ((pivot - first < n / 8 || last - (pivot + 1) < n / 8) && --bad_allowed == 0) {
+                tinystl::partial_sort(first, nth + 1, last, comp);
+                return;
+            }
+            if (nth < pivot) {
+                last = pivot;
+            } else {
+                first = pivot + 1;
+                leftmost = false;
+            }
+        }
+        tinystl::insertion_sort(first, last, comp);
+    }
+
+    template <class RandomIter>
+    void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
+        tinystl::nth_element(first, nth, last, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+}
+
+#endif //TINYSTL_SORT_H_
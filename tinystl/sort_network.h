@@ -0,0 +1,320 @@
+#ifndef TINYSTL_SORT_NETWORK_H_
+#define TINYSTL_SORT_NETWORK_H_
+
+// fixed size kernels: sorting networks, min and max selection and merges for a compile time N,
+// fully unrolled by template recursion and branchless when comparisons are
+
+#include <cstddef>
+#include <cstdint>
+
+#include "algobase.h"
+#include "functional.h"
+#include "iterator.h"
+#include "simd.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // arithmetic keys under the default orderings: a comparison is a flag and a conditional move,
+    // so the block partition and the sorting networks beat branching on it
+    template <class T, class Compared>
+    struct is_branchless_sortable : bool_constant<std::is_arithmetic<T>::value &&
+        (std::is_same<Compared, tinystl::less<T>>::value || std::is_same<Compared, tinystl::greater<T>>::value)> {};
+
+    // keys the vector networks of simd.h sort ascending
+    template <class T, class Compared>
+    struct is_simd_network_sortable : bool_constant<(std::is_same<T, int32_t>::value || std::is_same<T, uint32_t>::value ||
+        (std::is_same<T, float>::value && sizeof(float) == 4)) && std::is_same<Compared, tinystl::less<T>>::value> {};
+
+    // merge steps select with the flag through the index updates; float selects there compile to branches
+    template <class T, class Compared>
+    struct is_network_mergeable : bool_constant<std::is_integral<T>::value && is_branchless_sortable<T, Compared>::value> {};
+
+    template <class T, class Compared>
+    struct is_simd_network_mergeable : bool_constant<(std::is_same<T, int32_t>::value || std::is_same<T, uint32_t>::value) &&
+        std::is_same<Compared, tinystl::less<T>>::value> {};
+
+    // exchange of two branchless keys: both selects take the one flag
+    template <class T, class Compared, class = void>
+    struct network_exchange {
+        static void run(T& x, T& y, Compared comp) {
+            const bool c = comp(y, x);
+            const T lo = c ? y : x;
+            const T hi = c ? x : y;
+            x = lo;
+            y = hi;
+        }
+    };
+
+#if TINYSTL_SIMD_X86 && defined(__SSE2__)
+    // the compiler turns a float flag used twice into a branch; minss and maxss compute exactly
+    // a < b ? a : b and a > b ? a : b, ties and nan included
+    inline float network_min(float a, float b) noexcept { return _mm_cvtss_f32(_mm_min_ss(_mm_set_ss(a), _mm_set_ss(b))); }
+    inline float network_max(float a, float b) noexcept { return _mm_cvtss_f32(_mm_max_ss(_mm_set_ss(a), _mm_set_ss(b))); }
+    inline double network_min(double a, double b) noexcept { return _mm_cvtsd_f64(_mm_min_sd(_mm_set_sd(a), _mm_set_sd(b))); }
+    inline double network_max(double a, double b) noexcept { return _mm_cvtsd_f64(_mm_max_sd(_mm_set_sd(a), _mm_set_sd(b))); }
+
+    template <class T>
+    struct is_network_float : bool_constant<std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+    template <class T>
+    struct network_exchange<T, tinystl::less<T>, typename std::enable_if<is_network_float<T>::value>::type> {
+        static void run(T& x, T& y, tinystl::less<T>) {
+            const T lo = tinystl::network_min(y, x);
+            y = tinystl::network_max(x, y);
+            x = lo;
+        }
+    };
+
+    template <class T>
+    struct network_exchange<T, tinystl::greater<T>, typename std::enable_if<is_network_float<T>::value>::type> {
+        static void run(T& x, T& y, tinystl::greater<T>) {
+            const T hi = tinystl::network_max(y, x);
+            y = tinystl::network_min(x, y);
+            x = hi;
+        }
+    };
+#endif
+
+    // compare exchange: the smaller element to a
+    template <class RandomIter, class Compared>
+    void network_cmpx(RandomIter a, RandomIter b, Compared comp, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        value_type x = *a, y = *b;
+        network_exchange<value_type, Compared>::run(x, y, comp);
+        *a = x;
+        *b = y;
+    }
+
+    template <class RandomIter, class Compared>
+    void network_cmpx(RandomIter a, RandomIter b, Compared comp, tinystl::false_type) {
+        if (comp(*b, *a)) tinystl::iter_swap(a, b);
+    }
+
+    // batcher's odd even merge sort over the next power of two: the missing elements count as greater than
+    // all the others, so any comparator touching one of them is dropped
+    template <size_t I, size_t J, size_t N, bool = (J < N)>
+    struct network_pair {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter, Compared, Branchless) {}
+    };
+    template <size_t I, size_t J, size_t N>
+    struct network_pair<I, J, N, true> {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter first, Compared comp, Branchless b) { tinystl::network_cmpx(first + I, first + J, comp, b); }
+    };
+
+    // the comparators (i, i + R) for i = I, I + M, .. while i + R < End
+    template <size_t I, size_t End, size_t R, size_t M, size_t N, bool = (I + R < End)>
+    struct network_merge_pairs {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter, Compared, Branchless) {}
+    };
+    template <size_t I, size_t End, size_t R, size_t M, size_t N>
+    struct network_merge_pairs<I, End, R, M, N, true> {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter first, Compared comp, Branchless b) {
+            network_pair<I, I + R, N>::run(first, comp, b);
+            network_merge_pairs<I + M, End, R, M, N>::run(first, comp, b);
+        }
+    };
+
+    // merges the sorted halves of [Lo, Lo + Len), comparing elements R apart
+    template <size_t Lo, size_t Len, size_t R, size_t N, bool = (2 * R < Len)>
+    struct network_merge {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter first, Compared comp, Branchless b) {
+            network_merge<Lo, Len, 2 * R, N>::run(first, comp, b);
+            network_merge<Lo + R, Len, 2 * R, N>::run(first, comp, b);
+            network_merge_pairs<Lo + R, Lo + Len, R, 2 * R, N>::run(first, comp, b);
+        }
+    };
+    template <size_t Lo, size_t Len, size_t R, size_t N>
+    struct network_merge<Lo, Len, R, N, false> {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter first, Compared comp, Branchless b) { network_pair<Lo, Lo + R, N>::run(first, comp, b); }
+    };
+
+    template <size_t Lo, size_t Len, size_t N, bool = (Len > 1 && Lo < N)>
+    struct network_sort_range {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter, Compared, Branchless) {}
+    };
+    template <size_t Lo, size_t Len, size_t N>
+    struct network_sort_range<Lo, Len, N, true> {
+        template <class RandomIter, class Compared, class Branchless>
+        static void run(RandomIter first, Compared comp, Branchless b) {
+            network_sort_range<Lo, Len / 2, N>::run(first, comp, b);
+            network_sort_range<Lo + Len / 2, Len / 2, N>::run(first, comp, b);
+            network_merge<Lo, Len, 1, N>::run(first, comp, b);
+        }
+    };
+
+    constexpr size_t network_ceil2(size_t n, size_t p = 1) { return p >= n ? p : network_ceil2(n, 2 * p); }
+
+    // static sort: sorts [first, first + N)
+    template <size_t N, class RandomIter, class Compared>
+    void static_sort(RandomIter first, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        network_sort_range<0, network_ceil2(N), N>::run(first, comp, is_branchless_sortable<value_type, Compared>());
+    }
+
+    template <size_t N, class RandomIter>
+    void static_sort(RandomIter first) {
+        tinystl::static_sort<N>(first, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // runtime n from 8 to 16 through the vector network for 4 byte keys, false when it does not apply
+    template <class RandomIter, class Compared>
+    bool network_sort_simd(RandomIter, ptrdiff_t, Compared) { return false; }
+
+    template <class T, class Compared>
+    typename std::enable_if<is_simd_network_sortable<T, Compared>::value, bool>::type
+    network_sort_simd(T* first, ptrdiff_t n, Compared) {
+        return tinystl::simd_sort_small(first, static_cast<size_t>(n));
+    }
+
+    // min and max selection: a tournament of independent comparisons, ties go to the earlier element
+    template <size_t Lo, size_t Len>
+    struct network_select {
+        template <class RandomIter, class Better>
+        static RandomIter run(RandomIter first, Better better) {
+            const RandomIter a = network_select<Lo, Len / 2>::run(first, better);
+            const RandomIter b = network_select<Lo + Len / 2, Len - Len / 2>::run(first, better);
+            return better(*b, *a) ? b : a;
+        }
+    };
+    template <size_t Lo>
+    struct network_select<Lo, 1> {
+        template <class RandomIter, class Better>
+        static RandomIter run(RandomIter first, Better) { return first + Lo; }
+    };
+
+    template <class Compared>
+    struct network_reverse_compare {
+        Compared comp;
+        explicit network_reverse_compare(const Compared& c) : comp(c) {}
+        template <class T, class U>
+        bool operator()(const T& x, const U& y) const { return comp(y, x); }
+    };
+
+    template <size_t N, class RandomIter, class Compared>
+    RandomIter static_min_element(RandomIter first, Compared comp) {
+        static_assert(N > 0, "static_min_element needs an element");
+        return network_select<0, N>::run(first, comp);
+    }
+
+    template <size_t N, class RandomIter>
+    RandomIter static_min_element(RandomIter first) {
+        return tinystl::static_min_element<N>(first, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    template <size_t N, class RandomIter, class Compared>
+    RandomIter static_max_element(RandomIter first, Compared comp) {
+        static_assert(N > 0, "static_max_element needs an element");
+        return network_select<0, N>::run(first, network_reverse_compare<Compared>(comp));
+    }
+
+    template <size_t N, class RandomIter>
+    RandomIter static_max_element(RandomIter first) {
+        return tinystl::static_max_element<N>(first, tinystl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // merge step: one output element per call, with every index clamped into its range so the loads
+    // never branch; of two equivalent elements the one from the first range goes first
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    void network_merge_step(RandomIter1 first1, size_t& i, size_t n1, RandomIter2 first2, size_t& j, size_t n2,
+                            OutputIter& result, Compared comp, tinystl::true_type) {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        const value_type x = first1[i < n1 ? i : n1 - 1];
+        const value_type y = first2[j < n2 ? j : n2 - 1];
+        const bool take2 = (j < n2) & ((i >= n1) | comp(y, x));
+        *result = take2 ? y : x;
+        ++result;
+        i += !take2;
+        j += take2;
+    }
+
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    void network_merge_step(RandomIter1 first1, size_t& i, size_t n1, RandomIter2 first2, size_t& j, size_t n2,
+                            OutputIter& result, Compared comp, tinystl::false_type) {
+        if (j < n2 && (i >= n1 || comp(first2[j], first1[i]))) { *result = first2[j]; ++j; }
+        else { *result = first1[i]; ++i; }
+        ++result;
+    }
+
+    template <size_t K>
+    struct network_merge_steps {
+        template <class RandomIter1, class RandomIter2, class OutputIter, class Compared, class Branchless>
+        static void run(RandomIter1 first1, size_t& i, size_t n1, RandomIter2 first2, size_t& j, size_t n2,
+                        OutputIter& result, Compared comp, Branchless b) {
+            tinystl::network_merge_step(first1, i, n1, first2, j, n2, result, comp, b);
+            network_merge_steps<K - 1>::run(first1, i, n1, first2, j, n2, result, comp, b);
+        }
+    };
+    template <>
+    struct network_merge_steps<0> {
+        template <class RandomIter1, class RandomIter2, class OutputIter, class Compared, class Branchless>
+        static void run(RandomIter1, size_t&, size_t, RandomIter2, size_t&, size_t, OutputIter&, Compared, Branchless) {}
+    };
+
+    template <size_t N1, size_t N2, bool = (N1 != 0 && N2 != 0)>
+    struct network_merge_fixed {
+        template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+        static OutputIter run(RandomIter1 first1, RandomIter2 first2, OutputIter result, Compared) {
+            return tinystl::copy(first2, first2 + N2, tinystl::copy(first1, first1 + N1, result));
+        }
+    };
+    template <size_t N1, size_t N2>
+    struct network_merge_fixed<N1, N2, true> {
+        template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+        static OutputIter run(RandomIter1 first1, RandomIter2 first2, OutputIter result, Compared comp) {
+            typedef typename iterator_traits<RandomIter1>::value_type value_type;
+            typedef bool_constant<is_network_mergeable<value_type, Compared>::value &&
+                std::is_same<value_type, typename iterator_traits<RandomIter2>::value_type>::value> branchless;
+            size_t i = 0, j = 0;
+            network_merge_steps<N1 + N2>::run(first1, i, N1, first2, j, N2, result, comp, branchless());
+            return result;
+        }
+    };
+
+    // static merge: merges the sorted [first1, first1 + N1) and [first2, first2 + N2) into result
+    template <size_t N1, size_t N2, class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    OutputIter static_merge(RandomIter1 first1, RandomIter2 first2, OutputIter result, Compared comp) {
+        return network_merge_fixed<N1, N2>::run(first1, first2, result, comp);
+    }
+
+    template <size_t N1, size_t N2, class RandomIter1, class RandomIter2, class OutputIter>
+    OutputIter static_merge(RandomIter1 first1, RandomIter2 first2, OutputIter result) {
+        return tinystl::static_merge<N1, N2>(first1, first2, result, tinystl::less<typename iterator_traits<RandomIter1>::value_type>());
+    }
+
+    // the same steps for sizes known only at run time, a loop with a fixed trip count and no data dependent branch
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    OutputIter network_merge_loop(RandomIter1 first1, size_t n1, RandomIter2 first2, size_t n2, OutputIter result, Compared comp) {
+        if (n1 == 0 || n2 == 0) return tinystl::copy(first2, first2 + n2, tinystl::copy(first1, first1 + n1, result));
+        size_t i = 0, j = 0;
+        for (size_t k = n1 + n2; k != 0; --k) tinystl::network_merge_step(first1, i, n1, first2, j, n2, result, comp, tinystl::true_type());
+        return result;
+    }
+
+    // merges of integer keys with both sizes known only at run time; 4 byte integers go through the vector network
+    template <class RandomIter1, class RandomIter2, class OutputIter, class Compared>
+    OutputIter network_merge_small(RandomIter1 first1, size_t n1, RandomIter2 first2, size_t n2, OutputIter result, Compared comp) {
+        return tinystl::network_merge_loop(first1, n1, first2, n2, result, comp);
+    }
+
+    template <class Tp, class Up, class T, class Compared>
+    typename std::enable_if<is_simd_network_mergeable<T, Compared>::value &&
+        std::is_same<typename std::remove_const<Tp>::type, T>::value &&
+        std::is_same<typename std::remove_const<Up>::type, T>::value, T*>::type
+    network_merge_small(Tp* first1, size_t n1, Up* first2, size_t n2, T* result, Compared comp) {
+        // below one vector of keys the buffer round trip costs more than the scalar steps
+        if (n1 + n2 >= 8 && tinystl::simd_merge_small<T>(first1, n1, first2, n2, result)) return result + n1 + n2;
+        return tinystl::network_merge_loop(first1, n1, first2, n2, result, comp);
+    }
+
+}
+
+#endif //TINYSTL_SORT_NETWORK_H_
@@ -0,0 +1,393 @@
+#ifndef TINYSTL_THREAD_POOL_H_
+#define TINYSTL_THREAD_POOL_H_
+
+// work stealing thread pool: fork/join tasks on per worker chase-lev deques
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "util.h"
+
+namespace tinystl {
+
+    inline void pool_relax() noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // pin the calling thread to one cpu, false where affinity is not supported
+    inline bool pin_current_thread(unsigned cpu) noexcept {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % CPU_SETSIZE, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    // a forked unit of work, it lives on the stack of the thread that forked it until joined
+    struct pool_task {
+        void (*run)(pool_task*);
+        std::atomic<bool> done;
+        std::exception_ptr error;
+
+        explicit pool_task(void (*fn)(pool_task*)) : run(fn), done(false), error() {}
+
+        void execute() noexcept {
+            try { run(this); } catch (...) { error = std::current_exception(); }
+            done.store(true, std::memory_order_release);
+        }
+    };
+
+    template <class F>
+    struct pool_task_impl : public pool_task {
+        F& fn;
+        explicit pool_task_impl(F& f) : pool_task(&call), fn(f) {}
+        static void call(pool_task* t) { static_cast<pool_task_impl*>(t)->fn(); }
+    };
+
+    // chase-lev deque: the owner pushes and pops at the bottom, thieves take from the top.
+    // the capacity is fixed, fork/join nesting is logarithmic and a full deque runs the task inline
+    class work_deque {
+    public:
+        static const int64_t capacity = 4096;
+
+    private:
+        std::atomic<int64_t> top;
+        char pad_top[64 - sizeof(std::atomic<int64_t>)];
+        std::atomic<int64_t> bottom;
+        char pad_bottom[64 - sizeof(std::atomic<int64_t>)];
+        std::atomic<pool_task*> slots[capacity];
+
+    public:
+        work_deque() noexcept : top(0), bottom(0) {
+            for (int64_t i = 0; i < capacity; ++i) slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        bool push(pool_task* t) noexcept {
+            const int64_t b = bottom.load(std::memory_order_relaxed);
+            const int64_t tp = top.load(std::memory_order_acquire);
+            if (b - tp >= capacity) return false;
+            slots[b & (capacity - 1)].store(t, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_release);
+            return true;
+        }
+
+        pool_task* pop() noexcept {
+            const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t tp = top.load(std::memory_order_relaxed);
+            if (tp > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            pool_task* t = slots[b & (capacity - 1)].load(std::memory_order_relaxed);
+            if (tp == b) {
+                // last element: race the thieves for it
+                if (!top.compare_exchange_strong(tp, tp + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) t = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return t;
+        }
+
+        pool_task* steal() noexcept {
+            int64_t tp = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = bottom.load(std::memory_order_acquire);
+            if (tp >= b) return nullptr;
+            pool_task* t = slots[tp & (capacity - 1)].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(tp, tp + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr;
+            return t;
+        }
+
+        bool empty() const noexcept { return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed); }
+    };
+
+    class thread_pool;
+
+    struct pool_worker {
+        work_deque deque;
+        thread_pool* pool;
+        unsigned index;
+        uint32_t rng;
+        std::thread thread;
+
+        pool_worker() : deque(), pool(nullptr), index(0), rng(0), thread() {}
+
+        // the worker slot the calling thread runs in, if any
+        static pool_worker*& current() noexcept {
+            static thread_local pool_worker* worker = nullptr;
+            return worker;
+        }
+    };
+
+    // class: thread pool
+    // slot 0 belongs to the external thread that enters a parallel region, slots 1..n-1 are pool threads.
+    // one external thread at a time gets slot 0; concurrent regions from other threads run serially
+    class thread_pool {
+    private:
+        pool_worker* workers;
+        unsigned count;
+        bool pinned;
+        std::atomic<bool> stop;
+        std::atomic<bool> master_busy;
+        std::atomic<unsigned> sleeping;
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_cv;
+
+    public:
+        // threads == 0 sizes the pool from the hardware concurrency, pin binds pool thread i to cpu i
+        explicit thread_pool(unsigned threads = 0, bool pin = false);
+        ~thread_pool();
+
+    private:
+        thread_pool(const thread_pool&);
+        void operator=(const thread_pool&);
+
+    public:
+        // number of threads that execute tasks, the calling thread included
+        unsigned size() const noexcept { return count; }
+        bool is_pinned() const noexcept { return pinned; }
+
+        // run f and g, potentially in parallel, and return when both have finished
+        template <class F, class G>
+        void invoke(F&& f, G&& g);
+
+        // call f(begin, end) on disjoint chunks covering [first, last). chunks are split off lazily, only
+        // while other threads are idle, and never below grain elements (0 picks a grain from the size)
+        template <class Index, class F>
+        void parallel_for(Index first, Index last, F f, size_t grain = 0);
+
+    private:
+        class region_guard;
+
+        template <class F, class G>
+        void fork_join(pool_worker& self, F& f, G& g);
+        template <class Index, class F>
+        void parallel_for_split(Index first, Index last, F& f, size_t grain);
+        pool_task* steal_any(pool_worker& self) noexcept;
+        void wait_for(pool_worker& self, pool_task& task);
+        void notify_work();
+        bool has_work() const noexcept;
+        void worker_main(unsigned index);
+    };
+
+    // claims slot 0 for an external thread for the duration of a region
+    class thread_pool::region_guard {
+    private:
+        thread_pool* pool;
+    public:
+        explicit region_guard(thread_pool& p) : pool(nullptr) {
+            if (p.count > 1 && !p.master_busy.exchange(true, std::memory_order_acquire)) {
+                pool = &p;
+                pool_worker::current() = &p.workers[0];
+            }
+        }
+        ~region_guard() {
+            if (!pool) return;
+            pool_worker::current() = nullptr;
+            pool->master_busy.store(false, std::memory_order_release);
+        }
+        bool active() const noexcept { return pool != nullptr; }
+    };
+
+    inline thread_pool::thread_pool(unsigned threads, bool pin)
+        : workers(nullptr), count(0), pinned(pin), stop(false), master_busy(false), sleeping(0) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        count = threads;
+        workers = new pool_worker[count];
+        for (unsigned i = 0; i < count; ++i) {
+            workers[i].pool = this;
+            workers[i].index = i;
+            workers[i].rng = 0x9e3779b9u * (i + 1);
+        }
+        try {
+            for (unsigned i = 1; i < count; ++i) workers[i].thread = std::thread(&thread_pool::worker_main, this, i);
+        } catch (...) {
+            stop.store(true);
+            for (unsigned i = 1; i < count; ++i) if (workers[i].thread.joinable()) workers[i].thread.join();
+            delete[] workers;
+            throw;
+        }
+    }
+
+    inline thread_pool::~thread_pool() {
+        stop.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            sleep_cv.notify_all();
+        }
+        for (unsigned i = 1; i < count; ++i) workers[i].thread.join();
+        delete[] workers;
+    }
+
+    inline pool_task* thread_pool::steal_any(pool_worker& self) noexcept {
+        // xorshift for the first victim, then every other slot in order
+        uint32_t x = self.rng;
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        self.rng = x;
+        const unsigned start = x % count;
+        for (unsigned k = 0; k < count; ++k) {
+            const unsigned victim = (start + k) % count;
+            if (victim == self.index) continue;
+            pool_task* t = workers[victim].deque.steal();
+            if (t) return t;
+        }
+        return nullptr;
+    }
+
+    inline bool thread_pool::has_work() const noexcept {
+        for (unsigned i = 0; i < count; ++i) if (!workers[i].deque.empty()) return true;
+        return false;
+    }
+
+    // the fence pairs with the one a worker issues after announcing it sleeps:
+    // either the worker sees the new task or this sees the sleeper
+    inline void thread_pool::notify_work() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        sleep_cv.notify_one();
+    }
+
+    inline void thread_pool::worker_main(unsigned index) {
+        pool_worker& self = workers[index];
+        pool_worker::current() = &self;
+        if (pinned) tinystl::pin_current_thread(index);
+        unsigned idle = 0;
+        while (!stop.load(std::memory_order_acquire)) {
+            pool_task* t = steal_any(self);
+            if (t) {
+                t->execute();
+                idle = 0;
+                continue;
+            }
+            // spin, then yield, then sleep until a fork announces work
+            if (++idle < 64) { tinystl::pool_relax(); continue; }
+            if (idle < 128) { std::this_thread::yield(); continue; }
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleeping.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!stop.load(std::memory_order_acquire) && !has_work()) sleep_cv.wait_for(lock, std::chrono::milliseconds(10));
+            sleeping.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+        pool_worker::current() = nullptr;
+    }
+
+    // the forked task was stolen: run other tasks until the thief finishes it
+    inline void thread_pool::wait_for(pool_worker& self, pool_task& task) {
+        unsigned idle = 0;
+        while (!task.done.load(std::memory_order_acquire)) {
+            pool_task* t = steal_any(self);
+            if (t) {
+                t->execute();
+                idle = 0;
+            } else if (++idle < 64) {
+                tinystl::pool_relax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template <class F, class G>
+    void thread_pool::fork_join(pool_worker& self, F& f, G& g) {
+        pool_task_impl<G> right(g);
+        if (!self.deque.push(&right)) { f(); g(); return; }
+        notify_work();
+        std::exception_ptr left_error;
+        try { f(); } catch (...) { left_error = std::current_exception(); }
+        if (self.deque.pop() == &right) {
+            if (left_error) std::rethrow_exception(left_error);
+            g();
+            return;
+        }
+        wait_for(self, right);
+        if (left_error) std::rethrow_exception(left_error);
+        if (right.error) std::rethrow_exception(right.error);
+    }
+
+    template <class F, class G>
+    void thread_pool::invoke(F&& f, G&& g) {
+        pool_worker* self = pool_worker::current();
+        if (self && self->pool == this) { fork_join(*self, f, g); return; }
+        region_guard guard(*this);
+        if (guard.active()) fork_join(workers[0], f, g);
+        else { f(); g(); }
+    }
+
+    template <class Index, class F>
+    void thread_pool::parallel_for_split(Index first, Index last, F& f, size_t grain) {
+        pool_worker* self = pool_worker::current();
+        while (static_cast<size_t>(last - first) > grain) {
+            if (!self->deque.empty()) {
+                // the last split has not been stolen yet, nobody is idle: keep going serially
+                const Index next = first + grain;
+                f(first, next);
+                first = next;
+                continue;
+            }
+            const Index middle = first + (last - first) / 2;
+            auto left = [&]() { parallel_for_split(first, middle, f, grain); };
+            auto right = [&]() { parallel_for_split(middle, last, f, grain); };
+            fork_join(*self, left, right);
+            return;
+        }
+        if (first != last) f(first, last);
+    }
+
+    template <class Index, class F>
+    void thread_pool::parallel_for(Index first, Index last, F f, size_t grain) {
+        if (!(first < last)) return;
+        const size_t n = static_cast<size_t>(last - first);
+        if (grain == 0) grain = n / (static_cast<size_t>(count) * 64);
+        if (grain == 0) grain = 1;
+        pool_worker* self = pool_worker::current();
+        if (self && self->pool == this) { parallel_for_split(first, last, f, grain); return; }
+        region_guard guard(*this);
+        if (guard.active() && n > grain) parallel_for_split(first, last, f, grain);
+        else f(first, last);
+    }
+
+    // the process wide pool used by the parallel algorithms, sized from the hardware concurrency;
+    // define TINYSTL_POOL_THREADS to fix the thread count
+    inline thread_pool& default_thread_pool() {
+#ifdef TINYSTL_POOL_THREADS
+        static thread_pool pool(TINYSTL_POOL_THREADS);
+#else
+        static thread_pool pool;
+#endif
+        return pool;
+    }
+
+    template <class F, class G>
+    void parallel_invoke(F&& f, G&& g) {
+        tinystl::default_thread_pool().invoke(tinystl::forward<F>(f), tinystl::forward<G>(g));
+    }
+
+    template <class Index, class F>
+    void parallel_for(Index first, Index last, F f, size_t grain = 0) {
+        tinystl::default_thread_pool().parallel_for(first, last, f, grain);
+    }
+
+}
+
+#endif //TINYSTL_THREAD_POOL_H_
@@ -0,0 +1,107 @@
+#ifndef TINYSTL_TOP_K_H_
+#define TINYSTL_TOP_K_H_
+
+// streaming top k: the k greatest elements seen so far in a heap of k, all memory is allocated by the constructor
+
+#include <cstddef>
+
+#include "allocator.h"
+#include "construct.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // class: top k
+    // like priority_queue, greatest means last in comp order; the heap is ordered the other way round,
+    // so its root is the smallest element kept and an element that does not beat it costs one comparison
+    template <class T, class Compared = tinystl::less<T>>
+    class top_k {
+    public:
+        typedef T           value_type;
+        typedef Compared    value_compare;
+        typedef size_t      size_type;
+
+    private:
+        struct heap_compare {
+            Compared comp;
+            explicit heap_compare(const Compared& c) : comp(c) {}
+            bool operator()(const T& x, const T& y) const { return comp(y, x); }
+        };
+
+        T* heap;
+        size_type cap;
+        size_type len;
+        Compared comp;
+
+    public:
+        explicit top_k(size_type k, const Compared& c = Compared())
+            : heap(tinystl::allocator<T>::allocate(k)), cap(k), len(0), comp(c) {}
+        ~top_k() { clear(); tinystl::allocator<T>::deallocate(heap, cap); }
+
+    private:
+        top_k(const top_k&);
+        void operator=(const top_k&);
+
+    public:
+        void push(const value_type& value) {
+            if (len == cap) { if (cap != 0 && comp(*heap, value)) replace_top(value); }
+            else fill(value);
+        }
+        void push(value_type&& value) {
+            if (len == cap) { if (cap != 0 && comp(*heap, value)) replace_top(tinystl::move(value)); }
+            else fill(tinystl::move(value));
+        }
+        template <class InputIter>
+        void push(InputIter first, InputIter last) { for (; first != last; ++first) push(*first); }
+
+        // the smallest element kept, anything not greater than it is rejected once the heap is full
+        const value_type& top() const { return *heap; }
+
+        // moves the kept elements to result, greatest first, and leaves the accumulator empty
+        template <class OutputIter>
+        OutputIter drain(OutputIter result);
+
+        void clear() noexcept { tinystl::allocator<T>::destroy(heap, heap + len); len = 0; }
+
+        size_type size() const noexcept { return len; }
+        size_type capacity() const noexcept { return cap; }
+        bool empty() const noexcept { return len == 0; }
+        bool full() const noexcept { return len == cap; }
+        value_compare value_comp() const { return comp; }
+
+    private:
+        template <class V>
+        void fill(V&& value);
+        template <class V>
+        void replace_top(V&& value);
+    };
+
+    template <class T, class Compared>
+    template <class V>
+    void top_k<T, Compared>::fill(V&& value) {
+        tinystl::allocator<T>::construct(heap + len, tinystl::forward<V>(value));
+        ++len;
+        tinystl::push_heap(heap, heap + len, heap_compare(comp));
+    }
+
+    // sifts the new element down from the root in place of the old one
+    template <class T, class Compared>
+    template <class V>
+    void top_k<T, Compared>::replace_top(V&& value) {
+        tinystl::adjust_heap(heap, static_cast<ptrdiff_t>(0), static_cast<ptrdiff_t>(len), T(tinystl::forward<V>(value)), heap_compare(comp));
+    }
+
+    template <class T, class Compared>
+    template <class OutputIter>
+    OutputIter top_k<T, Compared>::drain(OutputIter result) {
+        tinystl::sort_heap(heap, heap + len, heap_compare(comp));
+        for (size_type i = 0; i < len; ++i, ++result) *result = tinystl::move(heap[i]);
+        clear();
+        return result;
+    }
+
+}
+
+#endif //TINYSTL_TOP_K_H_
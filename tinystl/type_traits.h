@@ -12,6 +12,15 @@ namespace tinystl{
     typedef bool_constant<true> true_type;
     typedef bool_constant<false> false_type;
 
+    // types whose equality is equality of their object representation
+    template <class T>
+    struct is_bitwise_comparable : bool_constant<std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value> {};
+
+    // types whose value initialisation is all zero bytes (a null member pointer is not);
+    // specialise for aggregates made only of such members
+    template <class T>
+    struct is_zero_constructible : bool_constant<std::is_scalar<T>::value && !std::is_member_pointer<T>::value> {};
+
     template <class T1, class T2> struct pair;
     template <class T>
     struct is_pair : tinystl::false_type{};
@@ -3,6 +3,15 @@
 
 // construct in uninitialized mem
 
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "algobase.h"
 #include "construct.h"
 #include "iterator.h"
@@ -17,11 +26,12 @@ namespace tinystl {
     }
     template <class InputIter, class ForwardIter>
     ForwardIter unchecked_uninit_copy(InputIter first, InputIter last, ForwardIter result, std::false_type) {
-        auto cur == result;
+        auto cur = result;
         try {
             for (; first != last; ++first, ++cur) { tinystl::construct(&*cur, *first); }
         } catch (...) {
-            for (; result != cur; --cur) tinystl::destroy(&*cur);
+            tinystl::destroy(result, cur);
+            throw;
         }
         return cur;
     }
@@ -41,7 +51,8 @@ namespace tinystl {
         try {
             for (; n > 0; --n, ++cur, ++first) { tinystl::construct(&*cur, *first); }
         } catch (...) {
-            for (; result != cur; --cur) tinystl::destroy(&*cur);
+            tinystl::destroy(result, cur);
+            throw;
         }
         return cur;
     }
@@ -61,7 +72,8 @@ namespace tinystl {
         try {
             for (; cur != last; ++cur) { tinystl::construct(&*cur, value); }
         } catch (...) {
-            for (; first != cur; ++first) tinystl::destroy(&*first);
+            tinystl::destroy(first, cur);
+            throw;
         }
     }
     template <class ForwardIter, class T>
@@ -80,7 +92,8 @@ namespace tinystl {
         try {
             for (; n > 0; --n, ++cur) { tinystl::construct(&*cur, value); }
         } catch (...) {
-            for (; first != cur; ++first) tinystl::destroy(&*first);
+            tinystl::destroy(first, cur);
+            throw;
         }
         return cur;
     }
@@ -101,6 +114,7 @@ namespace tinystl {
             for (; first != last; ++first, ++cur) { tinystl::construct(&*cur, tinystl::move(*first)); }
         } catch (...) {
             tinystl::destroy(result, cur);
+            throw;
         }
         return cur;
     }
@@ -120,8 +134,8 @@ namespace tinystl {
         try {
             for (; n > 0; --n, ++first, ++cur) { tinystl::construct(&*cur, tinystl::move(*first)); }
         } catch (...) {
-            for (; result != cur; ++result) tinystl::destroy(&*result);
-            throw ;
+            tinystl::destroy(result, cur);
+            throw;
         }
         return cur;
     }
@@ -129,6 +143,144 @@ namespace tinystl {
     ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
         return tinystl::unchecked_uninit_move_n(first, n, result, std::is_trivially_move_assignable<typename iterator_traits<InputIter>::value_type>{});
     }
+
+    // zero bytes: spans of at least this many bytes of private anonymous memory are handed back to the
+    // kernel, whose next touch of each page maps a zero page, so no zeros are written at all
+    const size_t uninit_zero_page_threshold = static_cast<size_t>(16) << 20;
+
+    inline bool uninit_zero_pages(void* ptr, size_t bytes) noexcept {
+#if defined(__linux__) && defined(MADV_DONTNEED)
+        if (bytes < uninit_zero_page_threshold) return false;
+        const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+        const uintptr_t lo = (addr + page - 1) & ~(page - 1);
+        const uintptr_t hi = (addr + bytes) & ~(page - 1);
+        if (hi <= lo) return false;
+        // only a private anonymous mapping reads back zeros once its pages are dropped, a file or shared
+        // mapping reads back its contents; the whole span has to lie in one such mapping. the table is
+        // only read, the mapping and its flags are left as they are
+        FILE* maps = std::fopen("/proc/self/maps", "r");
+        if (maps == nullptr) return false;
+        bool anonymous = false, line_start = true;
+        char line[512];
+        while (std::fgets(line, sizeof(line), maps)) {
+            // the tail of a line longer than the buffer, a long path name, is not a new mapping
+            const bool at_start = line_start;
+            line_start = std::strchr(line, '\n') != nullptr;
+            if (!at_start) continue;
+            unsigned long start, end, inode;
+            char perms[8];
+            if (std::sscanf(line, "%lx-%lx %7s %*s %*s %lu", &start, &end, perms, &inode) != 4) continue;
+            if (start <= lo && lo < end) { anonymous = hi <= end && std::strcmp(perms, "rw-p") == 0 && inode == 0; break; }
+        }
+        std::fclose(maps);
+        if (!anonymous || madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_DONTNEED) != 0) return false;
+        std::memset(ptr, 0, lo - addr);
+        std::memset(reinterpret_cast<void*>(hi), 0, addr + bytes - hi);
+        return true;
+#else
+        (void)ptr;
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    // anything else is zero filled, with non temporal stores once it outgrows the cache
+    inline void uninit_zero_bytes(void* ptr, size_t bytes) noexcept {
+        if (tinystl::uninit_zero_pages(ptr, bytes)) return;
+        const unsigned char zero = 0;
+        tinystl::simd_fill(ptr, &zero, 1, bytes);
+    }
+
+    // uninitialized value construct n: zero constructible elements in contiguous memory are zeroed in bulk
+    template <class ForwardIter, class Size>
+    ForwardIter unchecked_uninit_value_construct_n(ForwardIter first, Size n, std::true_type) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        if (n <= 0) return first;
+        tinystl::uninit_zero_bytes(tinystl::to_address(first), static_cast<size_t>(n) * sizeof(value_type));
+        return first + n;
+    }
+    template <class ForwardIter, class Size>
+    ForwardIter unchecked_uninit_value_construct_n(ForwardIter first, Size n, std::false_type) {
+        auto cur = first;
+        try {
+            for (; n > 0; --n, ++cur) { tinystl::construct(&*cur); }
+        } catch (...) {
+            tinystl::destroy(first, cur);
+            throw;
+        }
+        return cur;
+    }
+    template <class ForwardIter, class Size>
+    ForwardIter uninitialized_value_construct_n(ForwardIter first, Size n) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        return tinystl::unchecked_uninit_value_construct_n(first, n,
+            std::integral_constant<bool, is_contiguous_iterator<ForwardIter>::value && is_zero_constructible<value_type>::value>{});
+    }
+
+    // uninitialized value construct
+    template <class ForwardIter>
+    void unchecked_uninit_value_construct(ForwardIter first, ForwardIter last, std::true_type) {
+        tinystl::unchecked_uninit_value_construct_n(first, last - first, std::true_type());
+    }
+    template <class ForwardIter>
+    void unchecked_uninit_value_construct(ForwardIter first, ForwardIter last, std::false_type) {
+        auto cur = first;
+        try {
+            for (; cur != last; ++cur) { tinystl::construct(&*cur); }
+        } catch (...) {
+            tinystl::destroy(first, cur);
+            throw;
+        }
+    }
+    template <class ForwardIter>
+    void uninitialized_value_construct(ForwardIter first, ForwardIter last) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        tinystl::unchecked_uninit_value_construct(first, last,
+            std::integral_constant<bool, is_contiguous_iterator<ForwardIter>::value && is_zero_constructible<value_type>::value>{});
+    }
+
+    // uninitialized default construct n: trivially default constructible elements are left untouched
+    template <class ForwardIter, class Size>
+    ForwardIter unchecked_uninit_default_construct_n(ForwardIter first, Size n, std::true_type) {
+        if (n > 0) tinystl::advance(first, n);
+        return first;
+    }
+    template <class ForwardIter, class Size>
+    ForwardIter unchecked_uninit_default_construct_n(ForwardIter first, Size n, std::false_type) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        auto cur = first;
+        try {
+            for (; n > 0; --n, ++cur) { ::new ((void*)&*cur) value_type; }
+        } catch (...) {
+            tinystl::destroy(first, cur);
+            throw;
+        }
+        return cur;
+    }
+    template <class ForwardIter, class Size>
+    ForwardIter uninitialized_default_construct_n(ForwardIter first, Size n) {
+        return tinystl::unchecked_uninit_default_construct_n(first, n, std::is_trivially_default_constructible<typename iterator_traits<ForwardIter>::value_type>{});
+    }
+
+    // uninitialized default construct
+    template <class ForwardIter>
+    void unchecked_uninit_default_construct(ForwardIter, ForwardIter, std::true_type) {}
+    template <class ForwardIter>
+    void unchecked_uninit_default_construct(ForwardIter first, ForwardIter last, std::false_type) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        auto cur = first;
+        try {
+            for (; cur != last; ++cur) { ::new ((void*)&*cur) value_type; }
+        } catch (...) {
+            tinystl::destroy(first, cur);
+            throw;
+        }
+    }
+    template <class ForwardIter>
+    void uninitialized_default_construct(ForwardIter first, ForwardIter last) {
+        tinystl::unchecked_uninit_default_construct(first, last, std::is_trivially_default_constructible<typename iterator_traits<ForwardIter>::value_type>{});
+    }
 }
 
 #endif //TINYSTL_UNINITIALIZED_H_
@@ -135,9 +135,9 @@ namespace tinystl{
     template <class Ty1, class Ty2>
     bool operator>(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) { return rhs < lhs;}
     template <class Ty1, class Ty2>
-    bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) { return !(rhs < lhs)}
+    bool operator<=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) { return !(rhs < lhs);}
     template <class Ty1, class Ty2>
-    bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) { return !(lhs > rhs)}
+    bool operator>=(const pair<Ty1, Ty2>& lhs, const pair<Ty1, Ty2>& rhs) { return !(lhs > rhs);}
 
 
     // overload swap
@@ -0,0 +1,565 @@
+#ifndef TINYSTL_VIEWS_H_
+#define TINYSTL_VIEWS_H_
+
+// lazy range views: filter, transform, take, drop, zip and chunk as iterator adaptors, composed with operator|.
+// a pipeline is a pair of adapted iterators, so a sink walks the source once and nothing is buffered
+
+#include <cstddef>
+#include <new>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "heap_algo.h"
+#include "iterator.h"
+#include "numeric.h"
+#include "type_traits.h"
+#include "util.h"
+
+namespace tinystl {
+
+    // ranges: anything with begin() and end() members, and built in arrays
+    template <class Range>
+    auto range_begin(Range& r) -> decltype(r.begin()) { return r.begin(); }
+    template <class Range>
+    auto range_end(Range& r) -> decltype(r.end()) { return r.end(); }
+    template <class T, size_t N>
+    T* range_begin(T (&a)[N]) noexcept { return a; }
+    template <class T, size_t N>
+    T* range_end(T (&a)[N]) noexcept { return a + N; }
+
+    template <class Range>
+    struct range_iterator {
+        typedef decltype(tinystl::range_begin(std::declval<Range&>())) type;
+    };
+
+    template <class Range>
+    struct is_range {
+        private:
+            template <class U> static char test(decltype(tinystl::range_end(std::declval<U&>()))*);
+            template <class U> static long test(...);
+        public:
+            static const bool value = sizeof(test<typename std::remove_reference<Range>::type>(0)) == sizeof(char);
+    };
+
+    // the category of an adapted iterator: the base one, at most cap. for every adaptor here it names the
+    // traversal the adaptor implements, whether operator* yields a reference or a computed value as the
+    // transform, zip and chunk iterators do; the algorithms these views feed only rely on the traversal
+    template <class Category, class Cap>
+    struct view_category : public std::conditional<std::is_convertible<Category, Cap>::value, Cap, Category> {};
+
+    // steps it at most n times without passing last, never backwards
+    template <class Iter, class Distance>
+    Iter view_next(Iter it, Distance n, Iter last, tinystl::input_iterator_tag) {
+        for (; n > 0 && it != last; --n) ++it;
+        return it;
+    }
+    template <class Iter, class Distance>
+    Iter view_next(Iter it, Distance n, Iter last, tinystl::random_access_iterator_tag) {
+        return n <= 0 ? it : last - it < n ? last : it + n;
+    }
+
+    // callables held by iterators: lambdas have no default constructor and no copy assignment,
+    // so those are kept in a box that rebuilds on assignment and iterators stay regular
+    template <class F, bool = std::is_default_constructible<F>::value && std::is_copy_assignable<F>::value>
+    class view_fn {
+        F fn;
+    public:
+        view_fn() : fn() {}
+        explicit view_fn(const F& f) : fn(f) {}
+        template <class... Args>
+        auto operator()(Args&&... args) const -> decltype(std::declval<const F&>()(tinystl::forward<Args>(args)...)) {
+            return fn(tinystl::forward<Args>(args)...);
+        }
+    };
+
+    template <class F>
+    class view_fn<F, false> {
+        typename std::aligned_storage<sizeof(F), alignof(F)>::type buf;
+        bool engaged;
+
+        const F& get() const noexcept { return *reinterpret_cast<const F*>(&buf); }
+        void reset() noexcept { if (engaged) { reinterpret_cast<F*>(&buf)->~F(); engaged = false; } }
+
+    public:
+        view_fn() noexcept : engaged(false) {}
+        explicit view_fn(const F& f) : engaged(false) { ::new (static_cast<void*>(&buf)) F(f); engaged = true; }
+        view_fn(const view_fn& rhs) : engaged(false) {
+            if (rhs.engaged) { ::new (static_cast<void*>(&buf)) F(rhs.get()); engaged = true; }
+        }
+        view_fn& operator=(const view_fn& rhs) {
+            if (this != &rhs) {
+                reset();
+                if (rhs.engaged) { ::new (static_cast<void*>(&buf)) F(rhs.get()); engaged = true; }
+            }
+            return *this;
+        }
+        ~view_fn() { reset(); }
+
+        template <class... Args>
+        auto operator()(Args&&... args) const -> decltype(std::declval<const F&>()(tinystl::forward<Args>(args)...)) {
+            return get()(tinystl::forward<Args>(args)...);
+        }
+    };
+
+    // class: subrange
+    // an iterator pair, the type of every view; it does not own the elements, the source must outlive it
+    template <class Iter>
+    class subrange {
+    public:
+        typedef Iter                                                iterator;
+        typedef typename iterator_traits<Iter>::value_type          value_type;
+        typedef typename iterator_traits<Iter>::reference           reference;
+        typedef typename iterator_traits<Iter>::difference_type     difference_type;
+
+    private:
+        Iter first;
+        Iter last;
+
+    public:
+        subrange() : first(), last() {}
+        subrange(Iter f, Iter l) : first(f), last(l) {}
+
+        Iter begin() const { return first; }
+        Iter end() const { return last; }
+        bool empty() const { return first == last; }
+        // linear below random access
+        difference_type size() const { return tinystl::distance(first, last); }
+        reference operator[](difference_type n) const { return first[n]; }
+    };
+
+    template <class Iter>
+    subrange<Iter> make_subrange(Iter first, Iter last) { return subrange<Iter>(first, last); }
+
+    // filter iterator: stops only on elements satisfying the predicate, the predicate runs in operator++
+    template <class Iter, class Pred>
+    class filter_iterator {
+    public:
+        typedef typename view_category<typename iterator_traits<Iter>::iterator_category,
+            bidirectional_iterator_tag>::type                       iterator_category;
+        typedef typename iterator_traits<Iter>::value_type          value_type;
+        typedef typename iterator_traits<Iter>::difference_type     difference_type;
+        typedef typename iterator_traits<Iter>::pointer             pointer;
+        typedef typename iterator_traits<Iter>::reference           reference;
+        typedef filter_iterator<Iter, Pred>                         self;
+
+    private:
+        Iter cur;
+        Iter last;
+        view_fn<Pred> pred;
+
+        void satisfy() { while (cur != last && !pred(*cur)) ++cur; }
+
+    public:
+        filter_iterator() : cur(), last(), pred() {}
+        filter_iterator(Iter c, Iter l, const Pred& p) : cur(c), last(l), pred(p) { satisfy(); }
+
+        Iter base() const { return cur; }
+        reference operator*() const { return *cur; }
+
+        self& operator++() { ++cur; satisfy(); return *this; }
+        self operator++(int) { self tmp = *this; ++*this; return tmp; }
+        // an element satisfying the predicate must precede
+        self& operator--() { do --cur; while (!pred(*cur)); return *this; }
+        self operator--(int) { self tmp = *this; --*this; return tmp; }
+
+        bool operator==(const self& rhs) const { return cur == rhs.cur; }
+        bool operator!=(const self& rhs) const { return cur != rhs.cur; }
+    };
+
+    // transform iterator: applies the function on every dereference; the elements are computed,
+    // so it is at most random access
+    template <class Iter, class F>
+    class transform_iterator {
+    public:
+        typedef typename view_category<typename iterator_traits<Iter>::iterator_category,
+            random_access_iterator_tag>::type                       iterator_category;
+        typedef decltype(std::declval<const view_fn<F>&>()(*std::declval<const Iter&>())) reference;
+        typedef typename std::decay<reference>::type                value_type;
+        typedef typename iterator_traits<Iter>::difference_type     difference_type;
+        typedef void                                                pointer;
+        typedef transform_iterator<Iter, F>                         self;
+
+    private:
+        Iter cur;
+        view_fn<F> fn;
+
+    public:
+        transform_iterator() : cur(), fn() {}
+        transform_iterator(Iter c, const F& f) : cur(c), fn(f) {}
+        transform_iterator(Iter c, const view_fn<F>& f) : cur(c), fn(f) {}
+
+        Iter base() const { return cur; }
+        reference operator*() const { return fn(*cur); }
+        reference operator[](difference_type n) const { return fn(cur[n]); }
+
+        self& operator++() { ++cur; return *this; }
+        self operator++(int) { self tmp = *this; ++cur; return tmp; }
+        self& operator--() { --cur; return *this; }
+        self operator--(int) { self tmp = *this; --cur; return tmp; }
+        self& operator+=(difference_type n) { cur += n; return *this; }
+        self& operator-=(difference_type n) { cur -= n; return *this; }
+        self operator+(difference_type n) const { return self(cur + n, fn); }
+        self operator-(difference_type n) const { return self(cur - n, fn); }
+        difference_type operator-(const self& rhs) const { return cur - rhs.cur; }
+
+        bool operator==(const self& rhs) const { return cur == rhs.cur; }
+        bool operator!=(const self& rhs) const { return cur != rhs.cur; }
+        bool operator<(const self& rhs) const { return cur < rhs.cur; }
+        bool operator>(const self& rhs) const { return rhs.cur < cur; }
+        bool operator<=(const self& rhs) const { return !(rhs.cur < cur); }
+        bool operator>=(const self& rhs) const { return !(cur < rhs.cur); }
+    };
+
+    template <class Iter, class F>
+    transform_iterator<Iter, F> operator+(typename transform_iterator<Iter, F>::difference_type n, const transform_iterator<Iter, F>& it) {
+        return it + n;
+    }
+
+    // counted iterator: the first n elements of a range that cannot jump, the end is count 0 or the base end,
+    // whichever comes first
+    template <class Iter>
+    class counted_iterator {
+    public:
+        typedef typename view_category<typename iterator_traits<Iter>::iterator_category,
+            forward_iterator_tag>::type                             iterator_category;
+        typedef typename iterator_traits<Iter>::value_type          value_type;
+        typedef typename iterator_traits<Iter>::difference_type     difference_type;
+        typedef typename iterator_traits<Iter>::pointer             pointer;
+        typedef typename iterator_traits<Iter>::reference           reference;
+        typedef counted_iterator<Iter>                              self;
+
+    private:
+        Iter cur;
+        difference_type count;
+
+    public:
+        counted_iterator() : cur(), count(0) {}
+        counted_iterator(Iter c, difference_type n) : cur(c), count(n) {}
+
+        Iter base() const { return cur; }
+        difference_type remaining() const { return count; }
+        reference operator*() const { return *cur; }
+
+        self& operator++() { ++cur; --count; return *this; }
+        self operator++(int) { self tmp = *this; ++*this; return tmp; }
+
+        bool operator==(const self& rhs) const { return count == rhs.count || cur == rhs.cur; }
+        bool operator!=(const self& rhs) const { return !(*this == rhs); }
+    };
+
+    // zip iterator: pairs of references into two ranges, ending with the shorter one
+    template <class Iter1, class Iter2>
+    class zip_iterator {
+        typedef typename iterator_traits<Iter1>::iterator_category category1;
+        typedef typename iterator_traits<Iter2>::iterator_category category2;
+
+    public:
+        typedef typename std::conditional<std::is_convertible<category1, random_access_iterator_tag>::value &&
+            std::is_convertible<category2, random_access_iterator_tag>::value, random_access_iterator_tag,
+            typename std::conditional<std::is_convertible<category1, forward_iterator_tag>::value &&
+            std::is_convertible<category2, forward_iterator_tag>::value, forward_iterator_tag,
+            input_iterator_tag>::type>::type                        iterator_category;
+        typedef tinystl::pair<typename iterator_traits<Iter1>::value_type,
+            typename iterator_traits<Iter2>::value_type>            value_type;
+        typedef tinystl::pair<typename iterator_traits<Iter1>::reference,
+            typename iterator_traits<Iter2>::reference>             reference;
+        typedef typename iterator_traits<Iter1>::difference_type    difference_type;
+        typedef void                                                pointer;
+        typedef zip_iterator<Iter1, Iter2>                          self;
+
+    private:
+        Iter1 it1;
+        Iter2 it2;
+
+    public:
+        zip_iterator() : it1(), it2() {}
+        zip_iterator(Iter1 a, Iter2 b) : it1(a), it2(b) {}
+
+        Iter1 first_base() const { return it1; }
+        Iter2 second_base() const { return it2; }
+        reference operator*() const { return reference(*it1, *it2); }
+        reference operator[](difference_type n) const { return reference(it1[n], it2[n]); }
+
+        self& operator++() { ++it1; ++it2; return *this; }
+        self operator++(int) { self tmp = *this; ++*this; return tmp; }
+        self& operator--() { --it1; --it2; return *this; }
+        self operator--(int) { self tmp = *this; --*this; return tmp; }
+        self& operator+=(difference_type n) { it1 += n; it2 += n; return *this; }
+        self& operator-=(difference_type n) { it1 -= n; it2 -= n; return *this; }
+        self operator+(difference_type n) const { return self(it1 + n, it2 + n); }
+        self operator-(difference_type n) const { return self(it1 - n, it2 - n); }
+        difference_type operator-(const self& rhs) const { return it1 - rhs.it1; }
+
+        // either side reaching its end ends the zip
+        bool operator==(const self& rhs) const { return it1 == rhs.it1 || it2 == rhs.it2; }
+        bool operator!=(const self& rhs) const { return !(*this == rhs); }
+        bool operator<(const self& rhs) const { return it1 < rhs.it1; }
+        bool operator>(const self& rhs) const { return rhs.it1 < it1; }
+        bool operator<=(const self& rhs) const { return !(rhs.it1 < it1); }
+        bool operator>=(const self& rhs) const { return !(it1 < rhs.it1); }
+    };
+
+    template <class Iter1, class Iter2>
+    zip_iterator<Iter1, Iter2> operator+(typename zip_iterator<Iter1, Iter2>::difference_type n, const zip_iterator<Iter1, Iter2>& it) {
+        return it + n;
+    }
+
+    // chunk iterator: consecutive subranges of n elements, the last one may be shorter
+    template <class Iter>
+    class chunk_iterator {
+        static_assert(is_forward_iterator<Iter>::value, "chunk needs a forward range");
+
+    public:
+        typedef forward_iterator_tag                                iterator_category;
+        typedef subrange<Iter>                                      value_type;
+        typedef subrange<Iter>                                      reference;
+        typedef typename iterator_traits<Iter>::difference_type     difference_type;
+        typedef void                                                pointer;
+        typedef chunk_iterator<Iter>                                self;
+
+    private:
+        Iter cur;
+        Iter next;
+        Iter last;
+        difference_type n;
+
+    public:
+        chunk_iterator() : cur(), next(), last(), n(0) {}
+        chunk_iterator(Iter c, Iter l, difference_type k)
+            : cur(c), next(tinystl::view_next(c, k, l, tinystl::iterator_category(c))), last(l), n(k) {}
+
+        Iter base() const { return cur; }
+        reference operator*() const { return reference(cur, next); }
+
+        self& operator++() { cur = next; next = tinystl::view_next(cur, n, last, tinystl::iterator_category(cur)); return *this; }
+        self operator++(int) { self tmp = *this; ++*this; return tmp; }
+
+        bool operator==(const self& rhs) const { return cur == rhs.cur; }
+        bool operator!=(const self& rhs) const { return cur != rhs.cur; }
+    };
+
+    template <class Iter, class Pred>
+    using filter_view = subrange<filter_iterator<Iter, Pred>>;
+    template <class Iter, class F>
+    using transform_view = subrange<transform_iterator<Iter, F>>;
+    // random access ranges are cut directly, others count down
+    template <class Iter>
+    using take_view = subrange<typename std::conditional<is_random_access_iterator<Iter>::value, Iter, counted_iterator<Iter>>::type>;
+    template <class Iter>
+    using drop_view = subrange<Iter>;
+    template <class Iter1, class Iter2>
+    using zip_view = subrange<zip_iterator<Iter1, Iter2>>;
+    template <class Iter>
+    using chunk_view = subrange<chunk_iterator<Iter>>;
+
+    template <class Iter>
+    take_view<Iter> take_aux(Iter first, Iter last, ptrdiff_t n, tinystl::true_type) {
+        return take_view<Iter>(first, tinystl::view_next(first, n, last, random_access_iterator_tag()));
+    }
+    template <class Iter>
+    take_view<Iter> take_aux(Iter first, Iter last, ptrdiff_t n, tinystl::false_type) {
+        return take_view<Iter>(counted_iterator<Iter>(first, n), counted_iterator<Iter>(last, 0));
+    }
+
+    template <class Iter1, class Iter2>
+    zip_view<Iter1, Iter2> zip_aux(Iter1 f1, Iter1 l1, Iter2 f2, Iter2 l2, tinystl::true_type) {
+        const auto n = tinystl::min<ptrdiff_t>(l1 - f1, l2 - f2);
+        return zip_view<Iter1, Iter2>(zip_iterator<Iter1, Iter2>(f1, f2), zip_iterator<Iter1, Iter2>(f1 + n, f2 + n));
+    }
+    template <class Iter1, class Iter2>
+    zip_view<Iter1, Iter2> zip_aux(Iter1 f1, Iter1 l1, Iter2 f2, Iter2 l2, tinystl::false_type) {
+        return zip_view<Iter1, Iter2>(zip_iterator<Iter1, Iter2>(f1, f2), zip_iterator<Iter1, Iter2>(l1, l2));
+    }
+
+    namespace views {
+
+        template <class Range>
+        using iterator_t = typename range_iterator<typename std::remove_reference<Range>::type>::type;
+
+        template <class Range>
+        typename std::enable_if<is_range<Range>::value, subrange<iterator_t<Range>>>::type
+        all(Range&& r) { return subrange<iterator_t<Range>>(tinystl::range_begin(r), tinystl::range_end(r)); }
+
+        template <class Range, class Pred>
+        typename std::enable_if<is_range<Range>::value, filter_view<iterator_t<Range>, Pred>>::type
+        filter(Range&& r, Pred pred) {
+            typedef filter_iterator<iterator_t<Range>, Pred> iter;
+            return filter_view<iterator_t<Range>, Pred>(iter(tinystl::range_begin(r), tinystl::range_end(r), pred),
+                iter(tinystl::range_end(r), tinystl::range_end(r), pred));
+        }
+
+        template <class Range, class F>
+        typename std::enable_if<is_range<Range>::value, transform_view<iterator_t<Range>, F>>::type
+        transform(Range&& r, F f) {
+            typedef transform_iterator<iterator_t<Range>, F> iter;
+            return transform_view<iterator_t<Range>, F>(iter(tinystl::range_begin(r), f), iter(tinystl::range_end(r), f));
+        }
+
+        template <class Range>
+        typename std::enable_if<is_range<Range>::value, take_view<iterator_t<Range>>>::type
+        take(Range&& r, ptrdiff_t n) {
+            return tinystl::take_aux(tinystl::range_begin(r), tinystl::range_end(r), n < 0 ? 0 : n,
+                bool_constant<is_random_access_iterator<iterator_t<Range>>::value>());
+        }
+
+        template <class Range>
+        typename std::enable_if<is_range<Range>::value, drop_view<iterator_t<Range>>>::type
+        drop(Range&& r, ptrdiff_t n) {
+            const auto first = tinystl::range_begin(r);
+            const auto last = tinystl::range_end(r);
+            return drop_view<iterator_t<Range>>(tinystl::view_next(first, n < 0 ? 0 : n, last, tinystl::iterator_category(first)), last);
+        }
+
+        template <class Range1, class Range2>
+        typename std::enable_if<is_range<Range1>::value && is_range<Range2>::value, zip_view<iterator_t<Range1>, iterator_t<Range2>>>::type
+        zip(Range1&& r1, Range2&& r2) {
+            return tinystl::zip_aux(tinystl::range_begin(r1), tinystl::range_end(r1), tinystl::range_begin(r2), tinystl::range_end(r2),
+                bool_constant<is_random_access_iterator<iterator_t<Range1>>::value && is_random_access_iterator<iterator_t<Range2>>::value>());
+        }
+
+        template <class Range>
+        typename std::enable_if<is_range<Range>::value, chunk_view<iterator_t<Range>>>::type
+        chunk(Range&& r, ptrdiff_t n) {
+            typedef chunk_iterator<iterator_t<Range>> iter;
+            THROW_OUT_OF_RANGE_IF(n <= 0, "views::chunk: chunk size must be positive");
+            return chunk_view<iterator_t<Range>>(iter(tinystl::range_begin(r), tinystl::range_end(r), n),
+                iter(tinystl::range_end(r), tinystl::range_end(r), n));
+        }
+
+        // adaptors: the view with its range argument left open, applied by operator|
+        struct view_adaptor {};
+
+        template <class Pred>
+        struct filter_adaptor : public view_adaptor {
+            Pred pred;
+            explicit filter_adaptor(const Pred& p) : pred(p) {}
+            template <class Range>
+            filter_view<iterator_t<Range>, Pred> operator()(Range&& r) const { return views::filter(tinystl::forward<Range>(r), pred); }
+        };
+
+        template <class F>
+        struct transform_adaptor : public view_adaptor {
+            F fn;
+            explicit transform_adaptor(const F& f) : fn(f) {}
+            template <class Range>
+            transform_view<iterator_t<Range>, F> operator()(Range&& r) const { return views::transform(tinystl::forward<Range>(r), fn); }
+        };
+
+        struct take_adaptor : public view_adaptor {
+            ptrdiff_t n;
+            explicit take_adaptor(ptrdiff_t k) : n(k) {}
+            template <class Range>
+            take_view<iterator_t<Range>> operator()(Range&& r) const { return views::take(tinystl::forward<Range>(r), n); }
+        };
+
+        struct drop_adaptor : public view_adaptor {
+            ptrdiff_t n;
+            explicit drop_adaptor(ptrdiff_t k) : n(k) {}
+            template <class Range>
+            drop_view<iterator_t<Range>> operator()(Range&& r) const { return views::drop(tinystl::forward<Range>(r), n); }
+        };
+
+        struct chunk_adaptor : public view_adaptor {
+            ptrdiff_t n;
+            explicit chunk_adaptor(ptrdiff_t k) : n(k) {}
+            template <class Range>
+            chunk_view<iterator_t<Range>> operator()(Range&& r) const { return views::chunk(tinystl::forward<Range>(r), n); }
+        };
+
+        template <class Pred>
+        filter_adaptor<Pred> filter(Pred pred) { return filter_adaptor<Pred>(pred); }
+        template <class F>
+        transform_adaptor<F> transform(F f) { return transform_adaptor<F>(f); }
+        inline take_adaptor take(ptrdiff_t n) { return take_adaptor(n); }
+        inline drop_adaptor drop(ptrdiff_t n) { return drop_adaptor(n); }
+        inline chunk_adaptor chunk(ptrdiff_t n) {
+            THROW_OUT_OF_RANGE_IF(n <= 0, "views::chunk: chunk size must be positive");
+            return chunk_adaptor(n);
+        }
+
+        // r | views::filter(pred) | views::transform(f) | views::take(n)
+        template <class Range, class Adaptor>
+        auto operator|(Range&& r, const Adaptor& adaptor) -> typename std::enable_if<is_range<Range>::value &&
+            std::is_base_of<view_adaptor, Adaptor>::value, decltype(adaptor(tinystl::forward<Range>(r)))>::type {
+            return adaptor(tinystl::forward<Range>(r));
+        }
+
+    }
+
+    // range sinks: the algorithms over a whole range or view, a pipeline is consumed in the one pass of the algorithm
+    template <class Range, class OutputIter>
+    typename std::enable_if<is_range<Range>::value, OutputIter>::type
+    copy(Range&& r, OutputIter result) {
+        return tinystl::copy(tinystl::range_begin(r), tinystl::range_end(r), result);
+    }
+
+    template <class Range, class T, class BinaryOp>
+    typename std::enable_if<is_range<Range>::value, T>::type
+    accumulate(Range&& r, T init, BinaryOp op) {
+        return tinystl::accumulate(tinystl::range_begin(r), tinystl::range_end(r), init, op);
+    }
+
+    template <class Range, class T>
+    typename std::enable_if<is_range<Range>::value, T>::type
+    accumulate(Range&& r, T init) {
+        return tinystl::accumulate(tinystl::range_begin(r), tinystl::range_end(r), init);
+    }
+
+    template <class Range, class T, class BinaryOp>
+    typename std::enable_if<is_range<Range>::value, T>::type
+    reduce(Range&& r, T init, BinaryOp op) {
+        return tinystl::reduce(tinystl::range_begin(r), tinystl::range_end(r), init, op);
+    }
+
+    template <class Range, class T>
+    typename std::enable_if<is_range<Range>::value, T>::type
+    reduce(Range&& r, T init) {
+        return tinystl::reduce(tinystl::range_begin(r), tinystl::range_end(r), init);
+    }
+
+    template <class Range>
+    typename std::enable_if<is_range<Range>::value, typename iterator_traits<views::iterator_t<Range>>::value_type>::type
+    reduce(Range&& r) {
+        return tinystl::reduce(tinystl::range_begin(r), tinystl::range_end(r));
+    }
+
+    // heap algorithms over random access views of lvalues, e.g. a take or drop of an array
+    template <class Range>
+    typename std::enable_if<is_range<Range>::value>::type make_heap(Range&& r) {
+        tinystl::make_heap(tinystl::range_begin(r), tinystl::range_end(r));
+    }
+    template <class Range, class Compared>
+    typename std::enable_if<is_range<Range>::value>::type make_heap(Range&& r, Compared comp) {
+        tinystl::make_heap(tinystl::range_begin(r), tinystl::range_end(r), comp);
+    }
+
+    template <class Range>
+    typename std::enable_if<is_range<Range>::value>::type push_heap(Range&& r) {
+        tinystl::push_heap(tinystl::range_begin(r), tinystl::range_end(r));
+    }
+    template <class Range, class Compared>
+    typename std::enable_if<is_range<Range>::value>::type push_heap(Range&& r, Compared comp) {
+        tinystl::push_heap(tinystl::range_begin(r), tinystl::range_end(r), comp);
+    }
+
+    template <class Range>
+    typename std::enable_if<is_range<Range>::value>::type pop_heap(Range&& r) {
+        tinystl::pop_heap(tinystl::range_begin(r), tinystl::range_end(r));
+    }
+    template <class Range, class Compared>
+    typename std::enable_if<is_range<Range>::value>::type pop_heap(Range&& r, Compared comp) {
+        tinystl::pop_heap(tinystl::range_begin(r), tinystl::range_end(r), comp);
+    }
+
+    template <class Range>
+    typename std::enable_if<is_range<Range>::value>::type sort_heap(Range&& r) {
+        tinystl::sort_heap(tinystl::range_begin(r), tinystl::range_end(r));
+    }
+    template <class Range, class Compared>
+    typename std::enable_if<is_range<Range>::value>::type sort_heap(Range&& r, Compared comp) {
+        tinystl::sort_heap(tinystl::range_begin(r), tinystl::range_end(r), comp);
+    }
+
+}
+
+#endif //TINYSTL_VIEWS_H_